@@ -0,0 +1,218 @@
+#!/usr/bin/env python
+#
+# Copyright 2016-2025 by Martin Moene
+#
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+# bench/code_size.py
+#
+# Measure the code size and the instruction count of the hot operations of
+# nonstd::variant: copy- and move-construction, copy- and move-assignment,
+# assignment of a value, destruction, std::hash and visit() of one to three
+# variants, for variants of 2, 8 and 16 alternatives. Compiles one translation
+# unit at -O2 and reads the size of each function via nm and its instructions
+# via objdump. Prints CSV and, given a baseline CSV, fails if a function of a
+# configuration in the baseline became larger than a threshold.
+#
+
+from __future__ import print_function
+
+import argparse
+import csv
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+
+root = os.path.abspath( os.path.join( os.path.dirname( os.path.abspath( __file__ ) ), '..' ) )
+
+# Configuration:
+
+def_compiler     = 'c++'
+def_nm           = 'nm'
+def_objdump      = 'objdump'
+def_std          = 'c++17'
+def_alternatives = [ 2, 8, 16 ]
+def_visited      = [ 1, 2, 3 ]
+def_threshold    = 1.05
+
+key_columns = ( 'compiler', 'std', 'function' )
+
+def translation_unit( alternatives, visited ):
+    """Source with an extern "C" function per operation and variant size. The
+    special members of the alternatives are only declared, so that the code
+    of a function is that of the variant, not that of its alternatives."""
+
+    lines = [
+        '#include "nonstd/variant.hpp"',
+        'template< int N > struct t { int v; t(); t( t const & ); t( t && ) noexcept; t & operator=( t const & ); t & operator=( t && ) noexcept; ~t(); };',
+        'template< int N > struct std::hash< t<N> > { std::size_t operator()( t<N> const & x ) const { return static_cast<std::size_t>( x.v ); } };',
+        'struct sum { template< class... Ts > int operator()( Ts const &... ts ) const { int r = 0; int x[] = { 0, ( r += ts.v )... }; return r + x[0]; } };' ]
+
+    for k in alternatives:
+        lines.append( 'typedef nonstd::variant< {} > v{};'.format( ', '.join( 't<{}>'.format( n ) for n in range( k ) ), k ) )
+
+        lines.append( 'extern "C" void copy_construct_{0}( v{0} * p, v{0} const & v ) {{ new( p ) v{0}( v ); }}'.format( k ) )
+        lines.append( 'extern "C" void move_construct_{0}( v{0} * p, v{0} & v ) {{ new( p ) v{0}( std::move( v ) ); }}'.format( k ) )
+        lines.append( 'extern "C" void copy_assign_{0}( v{0} & a, v{0} const & b ) {{ a = b; }}'.format( k ) )
+        lines.append( 'extern "C" void move_assign_{0}( v{0} & a, v{0} & b ) {{ a = std::move( b ); }}'.format( k ) )
+        lines.append( 'extern "C" void assign_value_{0}( v{0} & a, t<{1}> const & x ) {{ a = x; }}'.format( k, k - 1 ) )
+        lines.append( 'extern "C" void destroy_{0}( v{0} * p ) {{ p->~v{0}(); }}'.format( k ) )
+        lines.append( 'extern "C" std::size_t hash_{0}( v{0} const & v ) {{ return std::hash< v{0} >()( v ); }}'.format( k ) )
+
+        for m in visited:
+            params = ', '.join( 'v{} const & x{}'.format( k, i ) for i in range( m ) )
+            args   = ', '.join( 'x{}'.format( i ) for i in range( m ) )
+
+            lines.append( 'extern "C" int visit_{0}_{1}( {2} ) {{ return nonstd::visit( sum(), {3} ); }}'.format( k, m, params, args ) )
+
+    return '\n'.join( lines ) + '\n'
+
+def run( command ):
+    result = subprocess.run( command, stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True )
+
+    if result.returncode != 0:
+        sys.exit( 'command failed: {}\n{}'.format( ' '.join( command ), result.stderr[:4000] ) )
+
+    return result.stdout
+
+def compiler_identity( compiler ):
+    """First line of --version, without the name the compiler was invoked with."""
+
+    line  = run( [ compiler, '--version' ] ).splitlines()[0].strip()
+    words = line.split( None, 1 )
+
+    return words[1] if len( words ) == 2 and words[0] == os.path.basename( compiler ) else line
+
+def symbol_sizes( nm, obj ):
+    """Size in bytes of each function in the text section."""
+
+    sizes = {}
+
+    for line in run( [ nm, '--size-sort', '--print-size', '--defined-only', obj ] ).splitlines():
+        fields = line.split()
+
+        if len( fields ) == 4 and fields[2] in 'tTwW':
+            sizes[ fields[3] ] = int( fields[1], 16 )
+
+    return sizes
+
+def instruction_counts( objdump, obj ):
+    """Number of instructions of each function in the disassembly."""
+
+    counts = {}
+    name   = None
+
+    for line in run( [ objdump, '-d', '--no-show-raw-insn', obj ] ).splitlines():
+        header = re.match( r'^[0-9a-f]+ <(.+)>:$', line )
+
+        if header:
+            name = header.group( 1 )
+            counts[ name ] = 0
+        elif name and re.match( r'^\s+[0-9a-f]+:\s+\S', line ):
+            counts[ name ] += 1
+
+    return counts
+
+def check_regressions( rows, baseline, threshold ):
+    """Rows with more bytes or instructions than threshold times the matching
+    baseline row, and the number of rows that have a baseline row."""
+
+    with open( baseline ) as f:
+        reference = dict( ( tuple( row[k] for k in key_columns ), row ) for row in csv.DictReader( f ) )
+
+    regressions = []
+    compared    = 0
+
+    for row in rows:
+        key = tuple( str( row[k] ) for k in key_columns )
+
+        if key in reference:
+            compared += 1
+            ref = reference[key]
+
+            if row['bytes'] > int( ref['bytes'] ) * threshold or row['instructions'] > int( ref['instructions'] ) * threshold:
+                regressions.append( ( row, ref ) )
+
+    return regressions, compared
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Measure code size and instruction count of variant operations.',
+        epilog="""""",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+
+    parser.add_argument( '--compiler'    , metavar='cxx' , default=def_compiler, help='compiler to use' )
+    parser.add_argument( '--nm'          , metavar='nm'  , default=def_nm      , help='nm to use' )
+    parser.add_argument( '--objdump'     , metavar='od'  , default=def_objdump , help='objdump to use' )
+    parser.add_argument( '--std'         , metavar='std' , default=def_std     , help='C++ standard, C++11 or later' )
+    parser.add_argument( '--option'      , metavar='opt' , default=[], action='append', help='additional compiler option' )
+    parser.add_argument( '--include'     , metavar='dir' , default=os.path.join( root, 'include' ), help='folder with nonstd/variant.hpp' )
+    parser.add_argument( '--alternatives', metavar='k'   , default=def_alternatives, type=int, nargs='+', help='numbers of alternatives per variant' )
+    parser.add_argument( '--visited'     , metavar='m'   , default=def_visited     , type=int, nargs='+', help='numbers of variants visited together' )
+    parser.add_argument( '--csv'         , metavar='file', help='also write the results to this file' )
+    parser.add_argument( '--baseline'    , metavar='file', help='CSV of an earlier run to compare with' )
+    parser.add_argument( '--threshold'   , metavar='f'   , default=def_threshold, type=float, help='fail if bytes or instructions exceed those of the baseline times this factor' )
+
+    opt = parser.parse_args()
+
+    workdir = tempfile.mkdtemp( prefix='variant-code-size-' )
+
+    try:
+        source = os.path.join( workdir, 'code-size.cpp' )
+        obj    = os.path.join( workdir, 'code-size.o' )
+
+        with open( source, 'w' ) as f:
+            f.write( translation_unit( opt.alternatives, opt.visited ) )
+
+        run( [ opt.compiler, '-std=' + opt.std, '-O2', '-c', '-o', obj, '-I' + opt.include,
+            '-Dvariant_CONFIG_SELECT_VARIANT=variant_VARIANT_NONSTD' ] + opt.option + [ source ] )
+
+        sizes        = symbol_sizes( opt.nm, obj )
+        instructions = instruction_counts( opt.objdump, obj )
+        compiler     = compiler_identity( opt.compiler )
+
+        # the extern "C" functions in the order of the source, then all functions together:
+
+        functions = re.findall( r'extern "C" \S+ (\w+)\(', translation_unit( opt.alternatives, opt.visited ) )
+
+        rows = []
+
+        for name in functions:
+            rows.append( dict( compiler=compiler, std=opt.std, function=name, bytes=sizes.get( name, 0 ), instructions=instructions.get( name, 0 ) ) )
+
+        rows.append( dict( compiler=compiler, std=opt.std, function='total', bytes=sum( sizes.values() ),
+            instructions=sum( instructions.get( name, 0 ) for name in sizes ) ) )
+
+        fieldnames = list( key_columns ) + [ 'bytes', 'instructions' ]
+
+        out = csv.DictWriter( sys.stdout, fieldnames=fieldnames )
+        out.writeheader()
+        out.writerows( rows )
+
+        if opt.csv:
+            with open( opt.csv, 'w' ) as f:
+                writer = csv.DictWriter( f, fieldnames=fieldnames )
+                writer.writeheader()
+                writer.writerows( rows )
+
+        if opt.baseline:
+            regressions, compared = check_regressions( rows, opt.baseline, opt.threshold )
+
+            if compared == 0:
+                print( 'note: baseline has no rows for compiler "{}" and {}; nothing compared'.format( compiler, opt.std ), file=sys.stderr )
+
+            for row, reference in regressions:
+                print( 'regression: {}: {} bytes, {} instructions; baseline {} bytes, {} instructions'.format(
+                    row['function'], row['bytes'], row['instructions'], reference['bytes'], reference['instructions'] ), file=sys.stderr )
+
+            if regressions:
+                sys.exit( 1 )
+    finally:
+        shutil.rmtree( workdir )
+
+if __name__== "__main__":
+    main()
@@ -0,0 +1,64 @@
+#!/usr/bin/env python
+#
+# Copyright 2016-2025 by Martin Moene
+#
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+# bench/compile-typelist.py
+#
+# Compare the front-end time of the recursive and the flat typelist
+# metafunctions (variant_CONFIG_FLAT_TYPELIST=0, 1) on a generated translation
+# unit with many distinct variants. Prints CSV.
+#
+
+from __future__ import print_function
+
+import argparse
+import os
+import tempfile
+
+from compile_time import translation_unit, compile_time
+
+def_compiler     = 'g++'
+def_std          = 'c++11'
+def_variants     = 100
+def_alternatives = 16
+def_repeat       = 3
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compare compile time of recursive and flat typelist metafunctions.',
+        epilog="""""",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+
+    parser.add_argument( '--compiler'    , metavar='cxx'  , default=def_compiler           , help='compiler to use' )
+    parser.add_argument( '--std'         , metavar='std'  , default=def_std                , help='C++ standard, C++11 or later' )
+    parser.add_argument( '--variants'    , metavar='n'    , default=def_variants    , type=int, help='number of distinct variants' )
+    parser.add_argument( '--alternatives', metavar='k'    , default=def_alternatives, type=int, help='number of alternatives per variant' )
+    parser.add_argument( '--repeat'      , metavar='r'    , default=def_repeat      , type=int, help='compilations per configuration, the fastest counts' )
+
+    opt = parser.parse_args()
+
+    include = os.path.join( os.path.dirname( os.path.abspath( __file__ ) ), '..', 'include' )
+
+    with tempfile.NamedTemporaryFile( mode='w', suffix='.cpp', delete=False ) as f:
+        f.write( translation_unit( opt.variants, opt.alternatives ) )
+        source = f.name
+
+    try:
+        print( 'typelist,std,variants,alternatives,seconds' )
+
+        for flat in ( 0, 1 ):
+            command = [ opt.compiler, '-std=' + opt.std, '-fsyntax-only', '-I' + include,
+                '-Dvariant_CONFIG_SELECT_VARIANT=variant_VARIANT_NONSTD',
+                '-Dvariant_CONFIG_FLAT_TYPELIST={}'.format( flat ), source ]
+
+            seconds = min( compile_time( command )[0] for _ in range( opt.repeat ) )
+
+            print( '{},{},{},{},{:.2f}'.format( 'flat' if flat else 'recursive', opt.std, opt.variants, opt.alternatives, seconds ) )
+    finally:
+        os.remove( source )
+
+if __name__== "__main__":
+    main()
@@ -0,0 +1,231 @@
+#!/usr/bin/env python
+#
+# Copyright 2016-2025 by Martin Moene
+#
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+# bench/compile_time.py
+#
+# Measure the compile time of translation units with many distinct variant
+# instantiations, for a matrix of variant counts, alternative counts and
+# numbers of variants visited together, and for headers generated with
+# different --max-types and --max-args. Prints CSV and, given the CSV of an
+# earlier run, fails if a configuration became slower than a threshold.
+#
+
+from __future__ import print_function
+
+import argparse
+import csv
+import itertools
+import os
+import re
+import resource
+import shutil
+import subprocess
+import sys
+import tempfile
+
+root = os.path.abspath( os.path.join( os.path.dirname( os.path.abspath( __file__ ) ), '..' ) )
+
+sys.path.insert( 0, os.path.join( root, 'script' ) )
+
+import generate_header
+
+# Configuration:
+
+def_compiler     = 'c++'
+def_std          = 'c++11'
+def_variants     = [ 10, 100, 1000 ]
+def_alternatives = [ 2, 8, 16 ]
+def_visited      = [ 1, 2, 5 ]
+def_max_types    = [ generate_header.def_max_types ]
+def_max_args     = [ generate_header.def_max_args ]
+def_repeat       = 3
+def_threshold    = 1.10
+def_max_visits   = 4096
+
+key_columns = ( 'compiler', 'std', 'max_types', 'max_args', 'variants', 'alternatives', 'visited' )
+
+def translation_unit( variants, alternatives, visited=0 ):
+    """Source with the given number of distinct variants, each of which is
+    assigned, queried and accessed per alternative; if visited > 0, groups of
+    that many variants are visited together."""
+
+    lines = [
+        '#include "nonstd/variant.hpp"',
+        'template< int N > struct a { int v; };',
+        'struct sum { template< class... Ts > int operator()( Ts const &... ts ) const { int r = 0; int x[] = { 0, ( r += ts.v )... }; return r + x[0]; } };' ]
+
+    for i in range( variants ):
+        types = [ 'a<{}>'.format( i * alternatives + k ) for k in range( alternatives ) ]
+        body  = ' '.join( 'v = {0}(); r += nonstd::holds_alternative< {0} >( v ) + nonstd::get< {0} >( v ).v;'.format( t ) for t in types )
+
+        lines.append( 'typedef nonstd::variant< {} > v{};'.format( ', '.join( types ), i ) )
+        lines.append( 'int f{0}( v{0} & v ) {{ int r = 0; {1} return r; }}'.format( i, body ) )
+
+    if visited > 0:
+        for i in range( 0, variants - visited + 1, visited ):
+            params = ', '.join( 'v{0} const & x{0}'.format( i + k ) for k in range( visited ) )
+            args   = ', '.join( 'x{}'.format( i + k ) for k in range( visited ) )
+
+            lines.append( 'int g{}( {} ) {{ return nonstd::visit( sum(), {} ); }}'.format( i, params, args ) )
+
+    return '\n'.join( lines ) + '\n'
+
+def compile_time( command ):
+    """User CPU time of the compiler in seconds, and its diagnostic output."""
+
+    before = resource.getrusage( resource.RUSAGE_CHILDREN ).ru_utime
+    result = subprocess.run( command, stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True )
+    after  = resource.getrusage( resource.RUSAGE_CHILDREN ).ru_utime
+
+    if result.returncode != 0:
+        sys.exit( 'compilation failed: {}\n{}'.format( ' '.join( command ), result.stderr[:4000] ) )
+
+    return after - before, result.stderr
+
+def accepts_option( compiler, option, workdir ):
+    """True if the compiler accepts the option for an empty translation unit."""
+
+    source = os.path.join( workdir, 'probe.cpp' )
+
+    with open( source, 'w' ) as f:
+        f.write( 'int main() {}\n' )
+
+    result = subprocess.run( [ compiler, option, '-c', '-o', os.path.join( workdir, 'probe.o' ), source ],
+        stdout=subprocess.PIPE, stderr=subprocess.PIPE, universal_newlines=True )
+
+    return result.returncode == 0 and 'unrecognized' not in result.stderr and 'unknown' not in result.stderr
+
+def time_report( text ):
+    """Template instantiation seconds and GC memory from GCC's -ftime-report, or ''."""
+
+    inst = re.search( r'^\s*template instantiation\s*:\s*([0-9.]+)', text, re.M )
+    ggc  = re.search( r'^\s*TOTAL\s*:.*?\s([0-9]+[kMG]?)\s*$', text, re.M )
+
+    return ( inst.group( 1 ) if inst else '', ggc.group( 1 ) if ggc else '' )
+
+def check_regressions( rows, baseline, threshold ):
+    """Rows that are slower than threshold times the matching baseline row."""
+
+    with open( baseline ) as f:
+        reference = dict( ( tuple( row[k] for k in key_columns ), float( row['seconds'] ) ) for row in csv.DictReader( f ) )
+
+    regressions = []
+
+    for row in rows:
+        key = tuple( str( row[k] ) for k in key_columns )
+
+        if key in reference and row['seconds'] > reference[key] * threshold:
+            regressions.append( ( row, reference[key] ) )
+
+    return regressions
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Measure compile time of variant instantiations.',
+        epilog="""""",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+
+    parser.add_argument( '--compiler'    , metavar='cxx', default=def_compiler, help='compiler to use' )
+    parser.add_argument( '--std'         , metavar='std', default=def_std     , help='C++ standard, C++11 or later' )
+    parser.add_argument( '--option'      , metavar='opt', default=[], action='append', help='additional compiler option' )
+    parser.add_argument( '--variants'    , metavar='n'  , default=def_variants    , type=int, nargs='+', help='numbers of distinct variants per translation unit' )
+    parser.add_argument( '--alternatives', metavar='k'  , default=def_alternatives, type=int, nargs='+', help='numbers of alternatives per variant' )
+    parser.add_argument( '--visited'     , metavar='m'  , default=def_visited     , type=int, nargs='+', help='numbers of variants visited together, 0 for none' )
+    parser.add_argument( '--max-types'   , metavar='t'  , default=def_max_types   , type=int, nargs='+', help='--max-types of the generated header' )
+    parser.add_argument( '--max-args'    , metavar='a'  , default=def_max_args    , type=int, nargs='+', help='--max-args of the generated header' )
+    parser.add_argument( '--max-visits'  , metavar='c'  , default=def_max_visits  , type=int, help='skip configurations where a visit has more alternative combinations' )
+    parser.add_argument( '--repeat'      , metavar='r'  , default=def_repeat      , type=int, help='compilations per configuration, the fastest counts' )
+    parser.add_argument( '--csv'         , metavar='file', help='also write the results to this file' )
+    parser.add_argument( '--trace-dir'   , metavar='dir' , help='keep -ftime-trace output here, if the compiler supports it' )
+    parser.add_argument( '--baseline'    , metavar='file', help='CSV of an earlier run to compare with' )
+    parser.add_argument( '--threshold'   , metavar='f'  , default=def_threshold, type=float, help='fail if seconds exceed baseline seconds times this factor' )
+
+    opt = parser.parse_args()
+
+    workdir = tempfile.mkdtemp( prefix='variant-compile-time-' )
+
+    try:
+        have_trace  = opt.trace_dir is not None and accepts_option( opt.compiler, '-ftime-trace', workdir )
+        have_report = accepts_option( opt.compiler, '-ftime-report', workdir )
+
+        if opt.trace_dir and not os.path.isdir( opt.trace_dir ):
+            os.makedirs( opt.trace_dir )
+
+        rows = []
+        out  = csv.writer( sys.stdout )
+        fieldnames = list( key_columns ) + [ 'seconds', 'instantiation_seconds', 'memory' ]
+
+        out.writerow( fieldnames )
+
+        for max_types, max_args in itertools.product( opt.max_types, opt.max_args ):
+            include = os.path.join( workdir, 'include-{}-{}'.format( max_types, max_args ) )
+            os.makedirs( os.path.join( include, 'nonstd' ) )
+
+            cwd = os.getcwd()
+            os.chdir( root )
+            generate_header.ProcessTemplate( 'template/variant.hpp', os.path.join( include, 'nonstd', 'variant.hpp' ), max_types, max_args, False )
+            os.chdir( cwd )
+
+            for variants, alternatives, visited in itertools.product( opt.variants, opt.alternatives, opt.visited ):
+                if alternatives > max_types or visited > max_args or visited > variants or alternatives ** visited > opt.max_visits:
+                    continue
+
+                name   = 'tu-{}-{}-{}-{}-{}'.format( max_types, max_args, variants, alternatives, visited )
+                source = os.path.join( workdir, name + '.cpp' )
+
+                with open( source, 'w' ) as f:
+                    f.write( translation_unit( variants, alternatives, visited ) )
+
+                command = [ opt.compiler, '-std=' + opt.std, '-c', '-o', os.path.join( workdir, name + '.o' ),
+                    '-I' + include, '-Dvariant_CONFIG_SELECT_VARIANT=variant_VARIANT_NONSTD' ] + opt.option
+
+                if have_trace:
+                    command.append( '-ftime-trace' )
+
+                seconds = None
+
+                for _ in range( opt.repeat ):
+                    t, diagnostics = compile_time( command + [ source ] )
+                    seconds = t if seconds is None else min( seconds, t )
+
+                instantiation, memory = '', ''
+
+                if have_report:
+                    _, diagnostics = compile_time( command + [ '-ftime-report', source ] )
+                    instantiation, memory = time_report( diagnostics )
+
+                if have_trace and os.path.exists( os.path.join( workdir, name + '.json' ) ):
+                    shutil.copy( os.path.join( workdir, name + '.json' ), opt.trace_dir )
+
+                row = dict( compiler=os.path.basename( opt.compiler ), std=opt.std, max_types=max_types, max_args=max_args,
+                    variants=variants, alternatives=alternatives, visited=visited,
+                    seconds=float( '{:.2f}'.format( seconds ) ), instantiation_seconds=instantiation, memory=memory )
+
+                rows.append( row )
+                out.writerow( [ '{:.2f}'.format( row[k] ) if k == 'seconds' else row[k] for k in fieldnames ] )
+                sys.stdout.flush()
+
+        if opt.csv:
+            with open( opt.csv, 'w' ) as f:
+                writer = csv.DictWriter( f, fieldnames=fieldnames )
+                writer.writeheader()
+                writer.writerows( rows )
+
+        if opt.baseline:
+            regressions = check_regressions( rows, opt.baseline, opt.threshold )
+
+            for row, reference in regressions:
+                print( 'regression: {}: {:.2f}s, baseline {:.2f}s'.format(
+                    ', '.join( '{}={}'.format( k, row[k] ) for k in key_columns ), row['seconds'], reference ), file=sys.stderr )
+
+            if regressions:
+                sys.exit( 1 )
+    finally:
+        shutil.rmtree( workdir )
+
+if __name__== "__main__":
+    main()
@@ -0,0 +1,211 @@
+// Nanoseconds and hardware counters per operation of nonstd::variant and
+// std::variant: visit(), copy- and move-assignment, emplace() over another
+// alternative, comparison and std::hash, over a million variants of four
+// alternatives in random order (C++17).
+//
+// The counters come from Linux perf_event_open(2), see perf-counters.hpp.
+// Where the kernel or the container does not provide a counter, e.g. with
+// /proc/sys/kernel/perf_event_paranoid above 2 or without CAP_PERFMON in a
+// container, its columns remain empty and only the time is reported.
+
+#include "nonstd/variant.hpp"
+#include "perf-counters.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <random>
+#include <string>
+#include <variant>
+#include <vector>
+
+struct point
+{
+    int x, y, z;
+};
+
+inline bool operator==( point const & a, point const & b ) { return a.x == b.x && a.y == b.y && a.z == b.z; }
+inline bool operator< ( point const & a, point const & b ) { return a.x < b.x || ( a.x == b.x && ( a.y < b.y || ( a.y == b.y && a.z < b.z ) ) ); }
+
+template<>
+struct std::hash<point>
+{
+    std::size_t operator()( point const & p ) const { return static_cast<std::size_t>( p.x * 31 + p.y * 7 + p.z ); }
+};
+
+struct weight
+{
+    long operator()( int i )                 const { return i; }
+    long operator()( double d )              const { return static_cast<long>( d ); }
+    long operator()( std::string const & s ) const { return static_cast<long>( s.size() ); }
+    long operator()( point const & p )       const { return p.x + p.y + p.z; }
+};
+
+// The two implementations, with their visit():
+
+struct nonstd_variant
+{
+    static constexpr char const * name = "nonstd::variant";
+
+    using type = nonstd::variant<int, double, std::string, point>;
+
+    template< typename F, typename V >
+    static long visit( F && f, V && v ) { return nonstd::visit( std::forward<F>( f ), std::forward<V>( v ) ); }
+};
+
+struct std_variant
+{
+    static constexpr char const * name = "std::variant";
+
+    using type = std::variant<int, double, std::string, point>;
+
+    template< typename F, typename V >
+    static long visit( F && f, V && v ) { return std::visit( std::forward<F>( f ), std::forward<V>( v ) ); }
+};
+
+template< typename V >
+std::vector<V> make_variants( std::size_t size, unsigned seed )
+{
+    std::mt19937 generator( seed );
+    std::uniform_int_distribution<int> alternative( 0, 3 );
+
+    std::vector<V> result;
+    result.reserve( size );
+
+    for ( std::size_t i = 0; i != size; ++i )
+    {
+        int const value = static_cast<int>( i );
+
+        switch ( alternative( generator ) )
+        {
+            case 0: result.emplace_back( value ); break;
+            case 1: result.emplace_back( 0.5 * value ); break;
+            case 2: result.emplace_back( std::string( static_cast<std::size_t>( value % 15 ), 'x' ) ); break;
+            default: result.emplace_back( point{ value, 1, 2 } ); break;
+        }
+    }
+    return result;
+}
+
+// Time and counters of the fastest of a few runs, per operation; prepare()
+// restores the variants before each run and is not measured:
+
+template< typename Prepare, typename Run >
+void report( char const * variant, char const * operation, std::size_t operations, bench::perf_counters & counters, long & sink, Prepare && prepare, Run && run )
+{
+    double best = 0;
+    bench::counter_values best_values = {};
+
+    for ( int i = 0; i != 5; ++i )
+    {
+        prepare();
+
+        auto const start = std::chrono::steady_clock::now();
+        counters.start();
+        sink += run();
+        bench::counter_values const values = counters.stop();
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+        if ( i == 0 || elapsed.count() < best )
+        {
+            best = elapsed.count();
+            best_values = values;
+        }
+    }
+
+    std::printf( "%s,%s,%.2f", variant, operation, 1e9 * best / static_cast<double>( operations ) );
+
+    for ( int c = 0; c != bench::counter_count; ++c )
+    {
+        if ( best_values.valid[c] )
+            std::printf( ",%.2f", static_cast<double>( best_values.value[c] ) / static_cast<double>( operations ) );
+        else
+            std::printf( "," );
+    }
+    std::printf( "\n" );
+}
+
+template< typename Impl >
+void run_operations( std::size_t size, bench::perf_counters & counters, long & sink )
+{
+    using V = typename Impl::type;
+
+    std::vector<V> const a = make_variants<V>( size, 42 );
+    std::vector<V> const b = make_variants<V>( size, 43 );
+
+    std::vector<V> source;
+    std::vector<V> target;
+
+    auto const nothing = [] {};
+    auto const restore = [&] { source = a; target = b; };
+
+    report( Impl::name, "visit", size, counters, sink, nothing, [&] {
+        long sum = 0;
+        for ( auto const & v : a )
+            sum += Impl::visit( weight(), v );
+        return sum;
+    } );
+
+    report( Impl::name, "copy-assign", size, counters, sink, restore, [&] {
+        for ( std::size_t i = 0; i != size; ++i )
+            target[i] = source[i];
+        return static_cast<long>( target.back().index() );
+    } );
+
+    report( Impl::name, "move-assign", size, counters, sink, restore, [&] {
+        for ( std::size_t i = 0; i != size; ++i )
+            target[i] = std::move( source[i] );
+        return static_cast<long>( target.back().index() );
+    } );
+
+    report( Impl::name, "emplace", size, counters, sink, restore, [&] {
+        for ( std::size_t i = 0; i != size; ++i )
+            target[i].template emplace<1>( 1.5 );
+        return static_cast<long>( target.back().index() );
+    } );
+
+    report( Impl::name, "compare", size, counters, sink, nothing, [&] {
+        long count = 0;
+        for ( std::size_t i = 0; i != size; ++i )
+            count += ( a[i] == b[i] ) + ( a[i] < b[i] );
+        return count;
+    } );
+
+    report( Impl::name, "hash", size, counters, sink, nothing, [&] {
+        std::size_t sum = 0;
+        for ( auto const & v : a )
+            sum += std::hash<V>()( v );
+        return static_cast<long>( sum & 0xffff );
+    } );
+}
+
+int main( int argc, char * argv[] )
+{
+    std::size_t const size = argc > 1 ? std::strtoul( argv[1], nullptr, 10 ) : 1000000;
+
+    bench::perf_counters counters;
+
+    if ( ! counters.unavailable_reason().empty() )
+    {
+        std::fprintf( stderr, "dispatch-counters: not all hardware counters are available (%s), their columns remain empty\n"
+            , counters.unavailable_reason().c_str() );
+    }
+
+    long sink = 0;
+
+    std::printf( "variant,operation,ns_per_op" );
+    for ( int c = 0; c != bench::counter_count; ++c )
+        std::printf( ",%s_per_op", bench::counter_name( c ) );
+    std::printf( "\n" );
+
+    run_operations< nonstd_variant >( size, counters, sink );
+    run_operations< std_variant    >( size, counters, sink );
+
+    // use the results, so that the loops are not optimized away:
+
+    return sink != 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// g++ -std=c++17 -O2 -I../include -Dvariant_CONFIG_SELECT_VARIANT=variant_VARIANT_NONSTD -o dispatch-counters dispatch-counters.cpp && dispatch-counters
@@ -0,0 +1,148 @@
+// Events per second of nonstd::fsm versus the state machine of
+// example/04-state-machine.cpp, which visits the state, returns an
+// optional<StateVariant> and copy-assigns it (C++17).
+
+#include "nonstd/variant_fsm.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <vector>
+
+struct event_start{};
+struct event_stop{};
+struct event_pause{};
+struct event_tick{};
+
+struct state_idle{};
+struct state_running{ long ticks = 0; };
+struct state_paused{};
+
+using state = nonstd::variant<state_idle, state_running, state_paused>;
+using event = nonstd::variant<event_start, event_stop, event_pause, event_tick>;
+
+// The approach of example/04-state-machine.cpp:
+
+template< typename Derived, typename StateVariant >
+class example_fsm
+{
+public:
+    template<typename Event>
+    void dispatch( Event && event )
+    {
+        Derived & child = static_cast<Derived &>( *this );
+
+        if ( auto new_state = nonstd::visit(
+            [&]( auto & s ) -> std::optional<StateVariant> {
+                return { child.on_event( s, std::forward<Event>( event ) ) };
+            }, m_state )
+        )
+        {
+            m_state = *std::move( new_state );
+        }
+    }
+
+private:
+    StateVariant m_state;
+};
+
+class example_machine : public example_fsm<example_machine, state>
+{
+public:
+    long ticks = 0;
+
+    template<typename State, typename Event>
+    std::optional<state> on_event( State const &, Event const & ) { return std::nullopt; }
+
+    std::optional<state> on_event( state_idle const &   , event_start const & ) { return state_running{}; }
+    std::optional<state> on_event( state_running const &, event_pause const & ) { return state_paused{}; }
+    std::optional<state> on_event( state_running const &, event_stop  const & ) { return state_idle{}; }
+    std::optional<state> on_event( state_running const &, event_tick  const & ) { ++ticks; return std::nullopt; }
+    std::optional<state> on_event( state_paused const & , event_start const & ) { return state_running{}; }
+    std::optional<state> on_event( state_paused const & , event_stop  const & ) { return state_idle{}; }
+};
+
+// The same machine with nonstd::fsm:
+
+struct transitions
+{
+    long ticks = 0;
+
+    state_running on_event( state_idle &   , event_start const & ) { return state_running{}; }
+    state_paused  on_event( state_running &, event_pause const & ) { return state_paused{}; }
+    state_idle    on_event( state_running &, event_stop  const & ) { return state_idle{}; }
+    void          on_event( state_running &, event_tick  const & ) { ++ticks; }
+    state_running on_event( state_paused & , event_start const & ) { return state_running{}; }
+    state_idle    on_event( state_paused & , event_stop  const & ) { return state_idle{}; }
+};
+
+using fsm_machine = nonstd::fsm<state, event, transitions>;
+
+// Timing:
+
+template< typename F >
+double events_per_second( std::size_t events, F && f )
+{
+    auto const start = std::chrono::steady_clock::now();
+    f();
+    std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+    return static_cast<double>( events ) / elapsed.count();
+}
+
+int main( int argc, char * argv[] )
+{
+    std::size_t const rounds = argc > 1 ? std::strtoul( argv[1], nullptr, 10 ) : 10000000;
+
+    // a run-time sequence of events, as from a queue:
+
+    std::vector<event> const sequence = {
+        event_start{}, event_tick{}, event_pause{}, event_tick{},
+        event_start{}, event_tick{}, event_stop{} , event_stop{} };
+
+    std::size_t const events = rounds * sequence.size();
+
+    example_machine example;
+    fsm_machine     machine;
+
+    double const example_typed = events_per_second( 4 * rounds, [&] {
+        for ( std::size_t i = 0; i != rounds; ++i )
+        {
+            example.dispatch( event_start{} ); example.dispatch( event_tick{} );
+            example.dispatch( event_pause{} ); example.dispatch( event_start{} );
+        }
+    } );
+
+    double const fsm_typed = events_per_second( 4 * rounds, [&] {
+        for ( std::size_t i = 0; i != rounds; ++i )
+        {
+            machine.dispatch( event_start{} ); machine.dispatch( event_tick{} );
+            machine.dispatch( event_pause{} ); machine.dispatch( event_start{} );
+        }
+    } );
+
+    double const example_variant = events_per_second( events, [&] {
+        for ( std::size_t i = 0; i != rounds; ++i )
+            for ( auto const & e : sequence )
+                nonstd::visit( [&]( auto const & x ) { example.dispatch( x ); }, e );
+    } );
+
+    double const fsm_variant = events_per_second( events, [&] {
+        for ( std::size_t i = 0; i != rounds; ++i )
+            for ( auto const & e : sequence )
+                machine.dispatch( e );
+    } );
+
+    std::printf( "approach,event,events_per_second\n" );
+    std::printf( "example,typed,%.0f\n"  , example_typed   );
+    std::printf( "fsm,typed,%.0f\n"      , fsm_typed       );
+    std::printf( "example,variant,%.0f\n", example_variant );
+    std::printf( "fsm,variant,%.0f\n"    , fsm_variant     );
+
+    // use the results, so that the loops are not optimized away:
+
+    return example.ticks == machine.transitions().ticks ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// g++ -std=c++17 -O2 -I../include -Dvariant_CONFIG_SELECT_VARIANT=variant_VARIANT_NONSTD -o fsm-dispatch fsm-dispatch.cpp && fsm-dispatch
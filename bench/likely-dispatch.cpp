@@ -0,0 +1,137 @@
+// Messages per second of visit(), match() and match_likely<quote>() over
+// streams of eight message types in which quote makes up 95% (skewed),
+// 100% (constant) and 12.5% (uniform) of the messages (C++17).
+//
+// Build once more with -Dvariant_CONFIG_LIKELY_INDEX=0 to have visit() test
+// for quote before its switch as well.
+
+#include "nonstd/variant_match.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+struct quote     { int bid; int ask; };
+struct trade     { int price; int size; };
+struct order_add { int id; int price; };
+struct order_del { int id; };
+struct order_mod { int id; int size; };
+struct status    { int code; };
+struct heartbeat {};
+struct snapshot  { int levels; };
+
+using message = nonstd::variant<quote, trade, order_add, order_del, order_mod, status, heartbeat, snapshot>;
+
+struct handler
+{
+    long operator()( quote     const & m ) const { return m.ask - m.bid; }
+    long operator()( trade     const & m ) const { return m.price * m.size; }
+    long operator()( order_add const & m ) const { return m.id + m.price; }
+    long operator()( order_del const & m ) const { return -m.id; }
+    long operator()( order_mod const & m ) const { return m.id ^ m.size; }
+    long operator()( status    const & m ) const { return m.code; }
+    long operator()( heartbeat const &   ) const { return 1; }
+    long operator()( snapshot  const & m ) const { return 2 * m.levels; }
+};
+
+// a stream with the given share of quotes and other messages uniformly distributed:
+
+std::vector<message> make_stream( std::size_t size, double quote_share )
+{
+    std::mt19937 generator( 42 );
+    std::uniform_real_distribution<double> share( 0.0, 1.0 );
+    std::uniform_int_distribution<int> other( 1, 7 );
+
+    std::vector<message> stream;
+    stream.reserve( size );
+
+    for ( std::size_t i = 0; i != size; ++i )
+    {
+        int const value = static_cast<int>( i );
+
+        switch ( share( generator ) < quote_share ? 0 : other( generator ) )
+        {
+            case 0: stream.emplace_back( quote{ value, value + 2 } ); break;
+            case 1: stream.emplace_back( trade{ value, 3 } ); break;
+            case 2: stream.emplace_back( order_add{ value, 7 } ); break;
+            case 3: stream.emplace_back( order_del{ value } ); break;
+            case 4: stream.emplace_back( order_mod{ value, 5 } ); break;
+            case 5: stream.emplace_back( status{ value } ); break;
+            case 6: stream.emplace_back( heartbeat{} ); break;
+            default: stream.emplace_back( snapshot{ value } ); break;
+        }
+    }
+    return stream;
+}
+
+// Timing, the fastest of a few runs:
+
+template< typename F >
+double messages_per_second( std::size_t messages, long & sink, F && f )
+{
+    double best = 0;
+
+    for ( int run = 0; run != 5; ++run )
+    {
+        auto const start = std::chrono::steady_clock::now();
+        sink += f();
+        std::chrono::duration<double> const elapsed = std::chrono::steady_clock::now() - start;
+
+        best = std::max( best, static_cast<double>( messages ) / elapsed.count() );
+    }
+    return best;
+}
+
+int main( int argc, char * argv[] )
+{
+    std::size_t const size = argc > 1 ? std::strtoul( argv[1], nullptr, 10 ) : 10000000;
+
+    struct { char const * name; double quote_share; } const streams[] = {
+        { "skewed"  , 0.95  },
+        { "constant", 1.0   },
+        { "uniform" , 0.125 },
+    };
+
+    long sink = 0;
+
+    std::printf( "stream,dispatch,messages_per_second\n" );
+
+    for ( auto const & s : streams )
+    {
+        std::vector<message> const stream = make_stream( size, s.quote_share );
+
+        double const visit = messages_per_second( size, sink, [&] {
+            long sum = 0;
+            for ( auto const & m : stream )
+                sum += nonstd::visit( handler(), m );
+            return sum;
+        } );
+
+        double const match = messages_per_second( size, sink, [&] {
+            long sum = 0;
+            for ( auto const & m : stream )
+                sum += nonstd::match( m, handler() );
+            return sum;
+        } );
+
+        double const match_likely = messages_per_second( size, sink, [&] {
+            long sum = 0;
+            for ( auto const & m : stream )
+                sum += nonstd::match_likely<quote>( m, handler() );
+            return sum;
+        } );
+
+        std::printf( "%s,visit,%.0f\n"       , s.name, visit        );
+        std::printf( "%s,match,%.0f\n"       , s.name, match        );
+        std::printf( "%s,match_likely,%.0f\n", s.name, match_likely );
+    }
+
+    // use the results, so that the loops are not optimized away:
+
+    return sink != 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// g++ -std=c++17 -O2 -I../include -Dvariant_CONFIG_SELECT_VARIANT=variant_VARIANT_NONSTD -o likely-dispatch likely-dispatch.cpp && likely-dispatch
@@ -0,0 +1,118 @@
+#!/usr/bin/env python
+#
+# Copyright 2016-2025 by Martin Moene
+#
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+# bench/module_parse.py
+#
+# Measure the compile time of translation units that use nonstd::variant via
+# #include "nonstd/variant.hpp" and via import nonstd.variant, for GCC
+# (-fmodules-ts) and Clang (--precompile). Prints CSV.
+#
+
+from __future__ import print_function
+
+import argparse
+import csv
+import os
+import shutil
+import sys
+import tempfile
+
+import compile_time
+
+root = compile_time.root
+
+# Configuration:
+
+def_compiler = 'g++'
+def_std      = 'c++20'
+def_variants = [ 0, 10, 100 ]
+def_repeat   = 5
+
+def translation_unit( variants, use_module ):
+    """Source that includes or imports variant and uses the given number of
+    distinct variants; the standard headers come first, as GCC requires."""
+
+    lines = [ '#include <new>' ]
+    lines.append( 'import nonstd.variant;' if use_module else '#include "nonstd/variant.hpp"' )
+    lines.append( 'template< int N > struct a { int v; };' )
+    lines.append( 'struct value { template< int N > int operator()( a<N> const & x ) const { return x.v; } };' )
+
+    for i in range( variants ):
+        types = ', '.join( 'a<{}>'.format( i * 4 + k ) for k in range( 4 ) )
+        lines.append( 'int f{0}( nonstd::variant< {1} > const & v ) {{ nonstd::variant< {1} > w = v; return nonstd::visit( value(), w ) + int( w.index() ); }}'.format( i, types ) )
+
+    return '\n'.join( lines ) + '\n'
+
+def is_clang( compiler ):
+    return 'clang' in os.path.basename( compiler )
+
+def build_module( compiler, std, options, workdir ):
+    """Compile module/variant.cppm; return the options to import it and the seconds it took."""
+
+    source = os.path.join( root, 'module', 'variant.cppm' )
+    common = [ compiler, '-std=' + std, '-I' + os.path.join( root, 'include' ),
+        '-Dvariant_CONFIG_SELECT_VARIANT=variant_VARIANT_NONSTD' ] + options
+
+    if is_clang( compiler ):
+        pcm = os.path.join( workdir, 'nonstd.variant.pcm' )
+        seconds, _ = compile_time.compile_time( common + [ '--precompile', '-o', pcm, source ] )
+        return [ '-fmodule-file=nonstd.variant=' + pcm ], seconds
+
+    seconds, _ = compile_time.compile_time( common + [ '-fmodules-ts', '-c', '-o', os.path.join( workdir, 'variant.o' ), '-x', 'c++', source ] )
+    return [ '-fmodules-ts' ], seconds
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Measure compile time with #include versus import of nonstd::variant.',
+        epilog="""""",
+        formatter_class=argparse.ArgumentDefaultsHelpFormatter)
+
+    parser.add_argument( '--compiler', metavar='cxx', default=def_compiler, help='compiler to use, GCC or Clang' )
+    parser.add_argument( '--std'     , metavar='std', default=def_std     , help='C++ standard, C++20 or later' )
+    parser.add_argument( '--option'  , metavar='opt', default=[], action='append', help='additional compiler option' )
+    parser.add_argument( '--variants', metavar='n'  , default=def_variants, type=int, nargs='+', help='numbers of distinct variants per translation unit' )
+    parser.add_argument( '--repeat'  , metavar='r'  , default=def_repeat  , type=int, help='compilations per configuration, the fastest counts' )
+
+    opt = parser.parse_args()
+
+    workdir = tempfile.mkdtemp( prefix='variant-module-' )
+    cwd = os.getcwd()
+
+    try:
+        # GCC reads and writes compiled modules in gcm.cache of the current directory:
+
+        os.chdir( workdir )
+
+        import_options, bmi_seconds = build_module( opt.compiler, opt.std, opt.option, workdir )
+
+        out = csv.writer( sys.stdout )
+        out.writerow( [ 'compiler', 'std', 'variants', 'mode', 'seconds' ] )
+        out.writerow( [ os.path.basename( opt.compiler ), opt.std, '', 'module interface', '{:.2f}'.format( bmi_seconds ) ] )
+
+        for variants in opt.variants:
+            for use_module in ( False, True ):
+                source = os.path.join( workdir, 'tu-{}-{}.cpp'.format( variants, int( use_module ) ) )
+
+                with open( source, 'w' ) as f:
+                    f.write( translation_unit( variants, use_module ) )
+
+                command = [ opt.compiler, '-std=' + opt.std, '-c', '-o', os.path.join( workdir, 'tu.o' ),
+                    '-I' + os.path.join( root, 'include' ), '-Dvariant_CONFIG_SELECT_VARIANT=variant_VARIANT_NONSTD' ] + opt.option
+
+                if use_module:
+                    command += import_options
+
+                seconds = min( compile_time.compile_time( command + [ source ] )[0] for _ in range( opt.repeat ) )
+
+                out.writerow( [ os.path.basename( opt.compiler ), opt.std, variants, 'import' if use_module else 'include', '{:.3f}'.format( seconds ) ] )
+                sys.stdout.flush()
+    finally:
+        os.chdir( cwd )
+        shutil.rmtree( workdir )
+
+if __name__== "__main__":
+    main()
@@ -0,0 +1,164 @@
+// Hardware counters of the calling thread via Linux perf_event_open(2):
+// instructions, branch misses and L1 data and instruction cache read misses.
+// Each counter is opened on its own, so that one the processor, hypervisor or
+// container does not provide only leaves that one unavailable. Elsewhere than
+// on Linux, no counter is available.
+
+#pragma once
+
+#ifndef NONSTD_VARIANT_BENCH_PERF_COUNTERS_HPP
+#define NONSTD_VARIANT_BENCH_PERF_COUNTERS_HPP
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#if defined( __linux__ )
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+namespace bench {
+
+enum counter
+{
+    instructions,
+    branch_misses,
+    l1d_misses,
+    l1i_misses,
+    counter_count
+};
+
+inline char const * counter_name( int c )
+{
+    static char const * const names[] = { "instructions", "branch_misses", "l1d_misses", "l1i_misses" };
+    return names[c];
+}
+
+struct counter_values
+{
+    bool          valid[ counter_count ];
+    std::uint64_t value[ counter_count ];
+};
+
+class perf_counters
+{
+public:
+    perf_counters()
+    {
+        for ( int c = 0; c != counter_count; ++c )
+        {
+            fd[c] = open( c );
+        }
+    }
+
+    ~perf_counters()
+    {
+#if defined( __linux__ )
+        for ( int c = 0; c != counter_count; ++c )
+        {
+            if ( fd[c] != -1 )
+                ::close( fd[c] );
+        }
+#endif
+    }
+
+    perf_counters( perf_counters const & ) = delete;
+    perf_counters & operator=( perf_counters const & ) = delete;
+
+    bool available( int c ) const { return fd[c] != -1; }
+
+    // why the first unavailable counter is not available, empty if all are:
+
+    std::string const & unavailable_reason() const { return reason; }
+
+    void start()
+    {
+#if defined( __linux__ )
+        for ( int c = 0; c != counter_count; ++c )
+        {
+            if ( fd[c] != -1 )
+            {
+                ::ioctl( fd[c], PERF_EVENT_IOC_RESET, 0 );
+                ::ioctl( fd[c], PERF_EVENT_IOC_ENABLE, 0 );
+            }
+        }
+#endif
+    }
+
+    counter_values stop()
+    {
+        counter_values result = {};
+#if defined( __linux__ )
+        for ( int c = 0; c != counter_count; ++c )
+        {
+            if ( fd[c] != -1 )
+                ::ioctl( fd[c], PERF_EVENT_IOC_DISABLE, 0 );
+        }
+
+        // value, time enabled and time running; scale a multiplexed counter:
+
+        for ( int c = 0; c != counter_count; ++c )
+        {
+            std::uint64_t data[3] = {};
+
+            if ( fd[c] != -1 && ::read( fd[c], data, sizeof data ) == static_cast<ssize_t>( sizeof data ) && data[2] != 0 )
+            {
+                result.valid[c] = true;
+                result.value[c] = data[2] == data[1] ? data[0]
+                    : static_cast<std::uint64_t>( static_cast<double>( data[0] ) * static_cast<double>( data[1] ) / static_cast<double>( data[2] ) );
+            }
+        }
+#endif
+        return result;
+    }
+
+private:
+    int open( int c )
+    {
+#if defined( __linux__ )
+        perf_event_attr attr;
+        std::memset( &attr, 0, sizeof attr );
+
+        attr.size           = sizeof attr;
+        attr.disabled       = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv     = 1;
+        attr.read_format    = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        std::uint64_t const read_miss = ( PERF_COUNT_HW_CACHE_OP_READ << 8 ) | ( PERF_COUNT_HW_CACHE_RESULT_MISS << 16 );
+
+        switch ( c )
+        {
+            case instructions : attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_INSTRUCTIONS;      break;
+            case branch_misses: attr.type = PERF_TYPE_HARDWARE; attr.config = PERF_COUNT_HW_BRANCH_MISSES;     break;
+            case l1d_misses   : attr.type = PERF_TYPE_HW_CACHE; attr.config = PERF_COUNT_HW_CACHE_L1D | read_miss; break;
+            default           : attr.type = PERF_TYPE_HW_CACHE; attr.config = PERF_COUNT_HW_CACHE_L1I | read_miss; break;
+        }
+
+        int const result = static_cast<int>( ::syscall( SYS_perf_event_open, &attr, 0, -1, -1, 0 ) );
+
+        if ( result == -1 && reason.empty() )
+        {
+            reason = std::string( counter_name( c ) ) + ": " + std::strerror( errno );
+        }
+        return result;
+#else
+        if ( reason.empty() )
+        {
+            reason = std::string( counter_name( c ) ) + ": perf_event_open() requires Linux";
+        }
+        return -1;
+#endif
+    }
+
+    int fd[ counter_count ];
+    std::string reason;
+};
+
+} // namespace bench
+
+#endif // NONSTD_VARIANT_BENCH_PERF_COUNTERS_HPP
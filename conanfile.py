@@ -6,7 +6,7 @@ class VariantLiteConan(ConanFile):
     description = "A single-file header-only version of a C++17-like variant, a type-safe union for C++98, C++11 and later"
     license = "Boost Software License - Version 1.0. http://www.boost.org/LICENSE_1_0.txt"
     url = "https://github.com/martinmoene/variant-lite.git"
-    exports_sources = "include/nonstd/*", "CMakeLists.txt", "cmake/*", "LICENSE.txt"
+    exports_sources = "include/nonstd/*", "module/*", "CMakeLists.txt", "cmake/*", "LICENSE.txt"
     settings = "compiler", "build_type", "arch"
     build_policy = "missing"
     author = "Martin Moene"
@@ -0,0 +1,24 @@
+// Formatting variants into a buffer without iostreams, see also 02-iostream.cpp.
+
+#include "nonstd/variant_format.hpp"
+
+#include <cstdio>
+#include <string>
+
+using namespace nonstd;
+
+int main()
+{
+    variant< char, int, double, std::string > var;
+    char buffer[ 64 ];
+
+    var = 'v';                         std::printf( "char:%.*s\n"       , int( format_to( buffer, sizeof( buffer ), var ) - buffer ), buffer );
+    var =  7 ;                         std::printf( "int:%.*s\n"        , int( format_to( buffer, sizeof( buffer ), var ) - buffer ), buffer );
+    var = 0.5;                         std::printf( "double:%.*s\n"     , int( format_to( buffer, sizeof( buffer ), var ) - buffer ), buffer );
+    var = std::string("hello, world"); std::printf( "std::string:%.*s\n", int( format_to( buffer, sizeof( buffer ), var ) - buffer ), buffer );
+}
+
+#if 0
+cl -EHsc -I../include 05-format.cpp && 05-format.exe
+g++ -std=c++11 -Wall -I../include -o 05-format.exe 05-format.cpp && 05-format.exe
+#endif
@@ -10,6 +10,11 @@
 #ifndef NONSTD_VARIANT_LITE_HPP
 #define NONSTD_VARIANT_LITE_HPP
 
+// variant-lite version and configuration, also in nonstd/variant_fwd.hpp:
+
+#ifndef NONSTD_VARIANT_LITE_CONFIG
+#define NONSTD_VARIANT_LITE_CONFIG
+
 #define variant_lite_MAJOR  3
 #define variant_lite_MINOR  0
 #define variant_lite_PATCH  0
@@ -105,6 +110,8 @@
 
 #define  variant_USES_STD_VARIANT  ( (variant_CONFIG_SELECT_VARIANT == variant_VARIANT_STD) || ((variant_CONFIG_SELECT_VARIANT == variant_VARIANT_DEFAULT) && variant_HAVE_STD_VARIANT) )
 
+#endif // NONSTD_VARIANT_LITE_CONFIG
+
 //
 // in_place: code duplicated in any-lite, expected-lite, optional-lite, value-ptr-lite, variant-lite:
 //
@@ -252,12 +259,25 @@ namespace nonstd {
     using std::operator>=;
     using std::swap;
 
-    constexpr auto variant_npos = std::variant_npos;
+    inline constexpr auto variant_npos = std::variant_npos;
 }
 
+// explicit instantiation of nonstd::variant operations, not applicable to std::variant:
+
+#define variant_INSTANTIATE( V )
+#define variant_EXTERN_INSTANTIATE( V )
+#define variant_INSTANTIATE_COMPARISON( V )
+#define variant_EXTERN_INSTANTIATE_COMPARISON( V )
+#define variant_INSTANTIATE_HASH( V )
+#define variant_EXTERN_INSTANTIATE_HASH( V )
+#define variant_INSTANTIATE_VISIT( Visitor, V )
+#define variant_EXTERN_INSTANTIATE_VISIT( Visitor, V )
+
 #else // variant_USES_STD_VARIANT
 
+#include <algorithm>
 #include <cstddef>
+#include <iterator>
 #include <limits>
 #include <new>
 #include <utility>
@@ -272,6 +292,13 @@ namespace nonstd {
 
 #define variant_CONFIG_MAX_TYPE_COUNT  16
 #define variant_CONFIG_MAX_VISITOR_ARG_COUNT  5
+#define variant_CONFIG_MAX_SWITCH_CASES  16
+
+// variant-lite dispatch configuration, index that visit() tests before its switch, -1 for none:
+
+#ifndef  variant_CONFIG_LIKELY_INDEX
+# define variant_CONFIG_LIKELY_INDEX  -1
+#endif
 
 // variant-lite alignment configuration:
 
@@ -287,6 +314,44 @@ namespace nonstd {
 # define variant_CONFIG_ALIGN_AS_FALLBACK  double
 #endif
 
+// variant-lite typelist configuration, flat metafunctions need C++11:
+
+#ifndef  variant_CONFIG_FLAT_TYPELIST
+# define variant_CONFIG_FLAT_TYPELIST  1
+#endif
+
+#define variant_USES_FLAT_TYPELIST  ( variant_CONFIG_FLAT_TYPELIST && variant_CPP11_OR_GREATER )
+
+// variant-lite storage configuration, a recursive union allows for constexpr variants (C++14):
+
+#ifndef  variant_CONFIG_UNION_STORAGE
+# define variant_CONFIG_UNION_STORAGE  ( variant_CPP14_OR_GREATER && ( variant_COMPILER_GNUC_VERSION == 0 || variant_COMPILER_GNUC_VERSION >= 500 ) )
+#endif
+
+#define variant_USES_UNION_STORAGE  ( variant_CONFIG_UNION_STORAGE && variant_CPP11_OR_GREATER )
+
+// variant-lite shared operations configuration, destroy, copy and move via tables of functions shared per alternative (C++11):
+
+#ifndef  variant_CONFIG_SHARED_OPS
+# define variant_CONFIG_SHARED_OPS  0
+#endif
+
+#define variant_USES_SHARED_OPS  ( variant_CONFIG_SHARED_OPS && variant_CPP11_OR_GREATER && ( variant_COMPILER_GNUC_VERSION == 0 || variant_COMPILER_GNUC_VERSION >= 500 ) )
+
+// variant-lite profiling configuration, count operations per variant type and alternative (C++11):
+
+#ifndef  variant_CONFIG_PROFILE
+# define variant_CONFIG_PROFILE  0
+#endif
+
+#define variant_USES_PROFILE  ( variant_CONFIG_PROFILE && variant_CPP11_OR_GREATER )
+
+#if variant_USES_PROFILE
+# include <atomic>
+# include <mutex>
+# include <typeinfo>
+#endif
+
 // half-open range [lo..hi):
 #define variant_BETWEEN( v, lo, hi ) ( (lo) <= (v) && (v) < (hi) )
 
@@ -376,6 +441,7 @@ namespace nonstd {
 // Presence of C++17 language features:
 
 #define variant_HAVE_NODISCARD          variant_CPP17_000
+#define variant_HAVE_INLINE_VARIABLE    variant_CPP17_000
 
 // Presence of C++ library features:
 
@@ -403,6 +469,35 @@ namespace nonstd {
 # define variant_constexpr14 /*constexpr*/
 #endif
 
+// constexpr for operations that construct and access an alternative as union member,
+// not with profiling, as counting is not possible in a constant expression:
+
+#if variant_USES_UNION_STORAGE && ! variant_USES_PROFILE
+# define variant_constexpr_union    variant_constexpr
+# define variant_constexpr14_union  variant_constexpr14
+#else
+# define variant_constexpr_union    /*constexpr*/
+# define variant_constexpr14_union  /*constexpr*/
+#endif
+
+// branch prediction hint:
+
+#if variant_COMPILER_GNUC_VERSION || variant_COMPILER_CLANG_VERSION
+# define variant_likely( expr )  __builtin_expect( !!( expr ), 1 )
+#else
+# define variant_likely( expr )  ( expr )
+#endif
+
+// keep a function out of line:
+
+#if variant_COMPILER_GNUC_VERSION || variant_COMPILER_CLANG_VERSION
+# define variant_noinline  __attribute__(( noinline ))
+#elif variant_COMPILER_MSVC_VERSION
+# define variant_noinline  __declspec( noinline )
+#else
+# define variant_noinline  /*noinline*/
+#endif
+
 #if variant_HAVE_NOEXCEPT
 # define variant_noexcept noexcept
 #else
@@ -427,6 +522,12 @@ namespace nonstd {
 # define variant_nodiscard /*[[nodiscard]]*/
 #endif
 
+#if variant_HAVE_INLINE_VARIABLE
+# define variant_inline17 inline
+#else
+# define variant_inline17 /*inline*/
+#endif
+
 #if variant_HAVE_OVERRIDE
 # define variant_override override
 #else
@@ -436,6 +537,7 @@ namespace nonstd {
 // additional includes:
 
 #if variant_CPP11_OR_GREATER
+# include <array>
 # include <functional>      // std::hash
 #endif
 
@@ -715,7 +817,7 @@ struct S15{}; typedef TX<S15> T15;
 typedef std::size_t type_index_t;
 
 #if variant_CPP11_OR_GREATER
-variant_constexpr type_index_t variant_npos = static_cast<type_index_t>( -1 );
+variant_inline17 variant_constexpr type_index_t variant_npos = static_cast<type_index_t>( -1 );
 #else
 static const type_index_t variant_npos = static_cast<type_index_t>( -1 );
 #endif
@@ -731,6 +833,349 @@ struct typelist
     typedef Tail tail;
 };
 
+#if variant_USES_FLAT_TYPELIST
+
+// Flat typelist metafunctions: a nested typelist is mapped to a pack in one
+// step and the metafunctions operate on the pack via constexpr arrays and
+// pack expansion, so that their instantiation depth does not grow with the
+// number of types, nor their instantiation count quadratically.
+
+template< class... Ts >
+struct typelist_pack {};
+
+template< class List >
+struct typelist_flat;
+
+template<>
+struct typelist_flat< nulltype >
+{
+    typedef typelist_pack<> type;
+};
+
+template< class A1 >
+struct typelist_flat< variant_TL1( A1 ) > { typedef typelist_pack< A1 > type; };
+template< class A1, class A2 >
+struct typelist_flat< variant_TL2( A1, A2 ) > { typedef typelist_pack< A1, A2 > type; };
+template< class A1, class A2, class A3 >
+struct typelist_flat< variant_TL3( A1, A2, A3 ) > { typedef typelist_pack< A1, A2, A3 > type; };
+template< class A1, class A2, class A3, class A4 >
+struct typelist_flat< variant_TL4( A1, A2, A3, A4 ) > { typedef typelist_pack< A1, A2, A3, A4 > type; };
+template< class A1, class A2, class A3, class A4, class A5 >
+struct typelist_flat< variant_TL5( A1, A2, A3, A4, A5 ) > { typedef typelist_pack< A1, A2, A3, A4, A5 > type; };
+template< class A1, class A2, class A3, class A4, class A5, class A6 >
+struct typelist_flat< variant_TL6( A1, A2, A3, A4, A5, A6 ) > { typedef typelist_pack< A1, A2, A3, A4, A5, A6 > type; };
+template< class A1, class A2, class A3, class A4, class A5, class A6, class A7 >
+struct typelist_flat< variant_TL7( A1, A2, A3, A4, A5, A6, A7 ) > { typedef typelist_pack< A1, A2, A3, A4, A5, A6, A7 > type; };
+template< class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8 >
+struct typelist_flat< variant_TL8( A1, A2, A3, A4, A5, A6, A7, A8 ) > { typedef typelist_pack< A1, A2, A3, A4, A5, A6, A7, A8 > type; };
+template< class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9 >
+struct typelist_flat< variant_TL9( A1, A2, A3, A4, A5, A6, A7, A8, A9 ) > { typedef typelist_pack< A1, A2, A3, A4, A5, A6, A7, A8, A9 > type; };
+template< class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9, class A10 >
+struct typelist_flat< variant_TL10( A1, A2, A3, A4, A5, A6, A7, A8, A9, A10 ) > { typedef typelist_pack< A1, A2, A3, A4, A5, A6, A7, A8, A9, A10 > type; };
+template< class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9, class A10, class A11 >
+struct typelist_flat< variant_TL11( A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11 ) > { typedef typelist_pack< A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11 > type; };
+template< class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9, class A10, class A11, class A12 >
+struct typelist_flat< variant_TL12( A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12 ) > { typedef typelist_pack< A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12 > type; };
+template< class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9, class A10, class A11, class A12, class A13 >
+struct typelist_flat< variant_TL13( A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13 ) > { typedef typelist_pack< A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13 > type; };
+template< class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9, class A10, class A11, class A12, class A13, class A14 >
+struct typelist_flat< variant_TL14( A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14 ) > { typedef typelist_pack< A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14 > type; };
+template< class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9, class A10, class A11, class A12, class A13, class A14, class A15 >
+struct typelist_flat< variant_TL15( A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15 ) > { typedef typelist_pack< A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15 > type; };
+template< class A1, class A2, class A3, class A4, class A5, class A6, class A7, class A8, class A9, class A10, class A11, class A12, class A13, class A14, class A15, class A16 >
+struct typelist_flat< variant_TL16( A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16 ) > { typedef typelist_pack< A1, A2, A3, A4, A5, A6, A7, A8, A9, A10, A11, A12, A13, A14, A15, A16 > type; };
+
+
+// padding types for unused variant parameters:
+
+template< class T >
+struct typelist_is_padding : std::false_type {};
+
+template<> struct typelist_is_padding< T0 > : std::true_type {};
+template<> struct typelist_is_padding< T1 > : std::true_type {};
+template<> struct typelist_is_padding< T2 > : std::true_type {};
+template<> struct typelist_is_padding< T3 > : std::true_type {};
+template<> struct typelist_is_padding< T4 > : std::true_type {};
+template<> struct typelist_is_padding< T5 > : std::true_type {};
+template<> struct typelist_is_padding< T6 > : std::true_type {};
+template<> struct typelist_is_padding< T7 > : std::true_type {};
+template<> struct typelist_is_padding< T8 > : std::true_type {};
+template<> struct typelist_is_padding< T9 > : std::true_type {};
+template<> struct typelist_is_padding< T10 > : std::true_type {};
+template<> struct typelist_is_padding< T11 > : std::true_type {};
+template<> struct typelist_is_padding< T12 > : std::true_type {};
+template<> struct typelist_is_padding< T13 > : std::true_type {};
+template<> struct typelist_is_padding< T14 > : std::true_type {};
+template<> struct typelist_is_padding< T15 > : std::true_type {};
+
+
+// values per type, with a sentinel to allow for an empty pack; evaluation
+// recurses over the array in a constant expression, not over instantiations:
+
+template< std::size_t N >
+struct typelist_values
+{
+    std::size_t v[ N + 1 ];
+};
+
+template< std::size_t N >
+constexpr std::size_t typelist_count( typelist_values<N> const & a, std::size_t i = 0 )
+{
+    return i == N ? 0 : a.v[i] + typelist_count( a, i + 1 );
+}
+
+template< std::size_t N >
+constexpr std::size_t typelist_find( typelist_values<N> const & a, std::size_t i = 0 )
+{
+    return i == N || a.v[i] ? i : typelist_find( a, i + 1 );
+}
+
+template< std::size_t N >
+constexpr std::size_t typelist_max( typelist_values<N> const & a, std::size_t i = 0, std::size_t m = 0 )
+{
+    return i == N ? m : typelist_max( a, i + 1, a.v[i] > m ? a.v[i] : m );
+}
+
+// index of the last maximum, as the recursive typelist_max_sizeof selects:
+
+template< std::size_t N >
+constexpr std::size_t typelist_find_last_max( typelist_values<N> const & a, std::size_t i = 0, std::size_t k = 0 )
+{
+    return i == N ? k : typelist_find_last_max( a, i + 1, a.v[i] >= a.v[k] ? i : k );
+}
+
+// type at index, via overload resolution against indexed bases:
+
+template< std::size_t... I >
+struct typelist_indices {};
+
+template< class L, class R >
+struct typelist_indices_concat;
+
+template< std::size_t... I, std::size_t... J >
+struct typelist_indices_concat< typelist_indices< I... >, typelist_indices< J... > >
+{
+    typedef typelist_indices< I..., ( sizeof...( I ) + J )... > type;
+};
+
+template< std::size_t N >
+struct make_typelist_indices
+    : typelist_indices_concat< typename make_typelist_indices< N / 2 >::type, typename make_typelist_indices< N - N / 2 >::type > {};
+
+template<> struct make_typelist_indices< 0 > { typedef typelist_indices<  > type; };
+template<> struct make_typelist_indices< 1 > { typedef typelist_indices< 0 > type; };
+
+template< std::size_t I, class T >
+struct typelist_indexed
+{
+    typedef T type;
+};
+
+template< class Indices, class... Ts >
+struct typelist_indexer;
+
+template< std::size_t... I, class... Ts >
+struct typelist_indexer< typelist_indices< I... >, Ts... > : typelist_indexed< I, Ts >... {};
+
+template< std::size_t I, class T >
+typelist_indexed< I, T > typelist_select( typelist_indexed< I, T > const * );
+
+template< class Pack, std::size_t I >
+struct typelist_pack_type_at;
+
+#if defined( __has_builtin )
+# if __has_builtin( __type_pack_element )
+#  define variant_HAVE_TYPE_PACK_ELEMENT  1
+# endif
+#endif
+
+#if defined( variant_HAVE_TYPE_PACK_ELEMENT )
+
+template< class... Ts, std::size_t I >
+struct typelist_pack_type_at< typelist_pack< Ts... >, I >
+{
+    typedef __type_pack_element< I, Ts... > type;
+};
+
+#else
+
+template< class... Ts, std::size_t I >
+struct typelist_pack_type_at< typelist_pack< Ts... >, I >
+{
+    typedef typename decltype( typelist_select< I >(
+        static_cast< typelist_indexer< typename make_typelist_indices< sizeof...( Ts ) >::type, Ts... > const * >( variant_nullptr ) ) )::type type;
+};
+
+#endif
+
+// pack metafunctions, each computes only its own value:
+
+template< class Pack >
+struct typelist_pack_size;
+
+template< class... Ts >
+struct typelist_pack_size< typelist_pack< Ts... > >
+{
+#if variant_CPP17_OR_GREATER
+    static constexpr std::size_t value = ( std::size_t( ! typelist_is_padding< Ts >::value ) + ... + 0 );
+#else
+    static constexpr std::size_t value = typelist_count( typelist_values< sizeof...( Ts ) >{ { std::size_t( ! typelist_is_padding< Ts >::value )..., 0 } } );
+#endif
+};
+
+template< class Pack, class T >
+struct typelist_pack_occurrences;
+
+template< class... Ts, class T >
+struct typelist_pack_occurrences< typelist_pack< Ts... >, T >
+{
+#if variant_CPP17_OR_GREATER
+    static constexpr std::size_t value = ( std::size_t( std::is_same< T, Ts >::value ) + ... + 0 );
+#else
+    static constexpr std::size_t value = typelist_count( typelist_values< sizeof...( Ts ) >{ { std::size_t( std::is_same< T, Ts >::value )..., 0 } } );
+#endif
+};
+
+// position of the first type that is T, or that T converts to; sizeof...( Ts ) if none:
+
+template< class Pack, class T >
+struct typelist_pack_find_same;
+
+template< class... Ts, class T >
+struct typelist_pack_find_same< typelist_pack< Ts... >, T >
+{
+    static constexpr std::size_t count = sizeof...( Ts );
+    static constexpr std::size_t value = typelist_find( typelist_values< sizeof...( Ts ) >{ { std::size_t( std::is_same< T, Ts >::value )..., 0 } } );
+};
+
+template< class Pack, class T >
+struct typelist_pack_find_convertible;
+
+template< class... Ts, class T >
+struct typelist_pack_find_convertible< typelist_pack< Ts... >, T >
+{
+    static constexpr std::size_t count = sizeof...( Ts );
+    static constexpr std::size_t value = typelist_find( typelist_values< sizeof...( Ts ) >{ { std::size_t( std::is_convertible< T, Ts >::value )..., 0 } } );
+};
+
+template< class Pack >
+struct typelist_pack_max_sizeof;
+
+template< class... Ts >
+struct typelist_pack_max_sizeof< typelist_pack< Ts... > >
+{
+    static constexpr std::size_t value = typelist_max( typelist_values< sizeof...( Ts ) >{ { sizeof( Ts )..., 0 } } );
+    static constexpr std::size_t index = typelist_find_last_max( typelist_values< sizeof...( Ts ) >{ { sizeof( Ts )..., 0 } } );
+};
+
+template< class Pack >
+struct typelist_pack_max_alignof;
+
+template< class... Ts >
+struct typelist_pack_max_alignof< typelist_pack< Ts... > >
+{
+    static constexpr std::size_t value = typelist_max( typelist_values< sizeof...( Ts ) >{ { alignof( Ts )..., 0 } } );
+};
+
+// typelist max element size:
+
+template< class List >
+struct typelist_max_sizeof
+{
+private:
+    typedef typename typelist_flat< List >::type pack;
+
+public:
+    enum V { value = typelist_pack_max_sizeof< pack >::value };
+
+    typedef typename typelist_pack_type_at< pack, typelist_pack_max_sizeof< pack >::index >::type type;
+};
+
+template<>
+struct typelist_max_sizeof< nulltype >
+{
+    enum V { value = 0 } ;
+    typedef void type;
+};
+
+// typelist max alignof element type:
+
+template< class List >
+struct typelist_max_alignof
+{
+    enum V { value = typelist_pack_max_alignof< typename typelist_flat< List >::type >::value };
+};
+
+// typelist size (length):
+
+template< class List >
+struct typelist_size
+{
+   enum V { value = 1 };
+};
+
+template<> struct typelist_size< T0 > { enum V { value = 0 }; };
+template<> struct typelist_size< T1 > { enum V { value = 0 }; };
+template<> struct typelist_size< T2 > { enum V { value = 0 }; };
+template<> struct typelist_size< T3 > { enum V { value = 0 }; };
+template<> struct typelist_size< T4 > { enum V { value = 0 }; };
+template<> struct typelist_size< T5 > { enum V { value = 0 }; };
+template<> struct typelist_size< T6 > { enum V { value = 0 }; };
+template<> struct typelist_size< T7 > { enum V { value = 0 }; };
+template<> struct typelist_size< T8 > { enum V { value = 0 }; };
+template<> struct typelist_size< T9 > { enum V { value = 0 }; };
+template<> struct typelist_size< T10 > { enum V { value = 0 }; };
+template<> struct typelist_size< T11 > { enum V { value = 0 }; };
+template<> struct typelist_size< T12 > { enum V { value = 0 }; };
+template<> struct typelist_size< T13 > { enum V { value = 0 }; };
+template<> struct typelist_size< T14 > { enum V { value = 0 }; };
+template<> struct typelist_size< T15 > { enum V { value = 0 }; };
+
+
+template<> struct typelist_size< nulltype > { enum V { value = 0 } ; };
+
+template< class Head, class Tail >
+struct typelist_size< typelist<Head, Tail> >
+{
+    enum V { value = typelist_pack_size< typename typelist_flat< typelist<Head, Tail> >::type >::value };
+};
+
+// typelist index of type:
+
+template< class List, class T >
+struct typelist_index_of
+{
+private:
+    typedef typelist_pack_find_same< typename typelist_flat< List >::type, T > find;
+
+public:
+    enum V { value = find::value == find::count ? -1 : int( find::value ) };
+};
+
+// typelist type at index:
+
+template< class List, std::size_t i >
+struct typelist_type_at
+{
+    typedef typename typelist_pack_type_at< typename typelist_flat< List >::type, i >::type type;
+};
+
+// typelist type is unique:
+
+template< class List, std::size_t CmpIndex >
+struct typelist_type_is_unique
+{
+    enum V { value = typelist_pack_occurrences< typename typelist_flat< List >::type, typename typelist_type_at< List, CmpIndex >::type >::value == 1 };
+};
+
+template< class List, class T >
+struct typelist_contains_unique_type
+{
+    enum V { value = typelist_pack_occurrences< typename typelist_flat< List >::type, T >::value == 1 };
+};
+
+#else // variant_USES_FLAT_TYPELIST
+
 // typelist max element size:
 
 template< class List >
@@ -885,6 +1330,8 @@ struct typelist_contains_unique_type : typelist_type_is_unique< List, typelist_i
 {
 };
 
+#endif // variant_USES_FLAT_TYPELIST
+
 //
 // Mechanism to allow for convertible types.
 // Inspired on mapbox variant, https://github.com/mapbox/variant.
@@ -892,6 +1339,37 @@ struct typelist_contains_unique_type : typelist_type_is_unique< List, typelist_i
 
 #if variant_CPP11_OR_GREATER
 
+#if variant_USES_FLAT_TYPELIST
+
+// number of alternatives after the one found at position Found, as the
+// recursive direct_type and convertible_type yield; variant_npos if none:
+
+template< class Find, class Pack >
+struct typelist_reverse_index
+{
+private:
+    static constexpr std::size_t size = typelist_pack_size< Pack >::value;
+
+public:
+    static constexpr type_index_t index = Find::value == Find::count
+        ? variant_npos
+        : Find::value < size ? static_cast<type_index_t>( size - 1 - Find::value ) : 0;
+};
+
+// direct_type:
+
+template <typename T, typename Typelist>
+struct direct_type : typelist_reverse_index<
+    typelist_pack_find_same< typename typelist_flat< Typelist >::type, T >, typename typelist_flat< Typelist >::type > {};
+
+// convertible_type:
+
+template <typename T, typename Typelist>
+struct convertible_type : typelist_reverse_index<
+    typelist_pack_find_convertible< typename typelist_flat< Typelist >::type, T >, typename typelist_flat< Typelist >::type > {};
+
+#else // variant_USES_FLAT_TYPELIST
+
 // direct_type:
 
 template <typename T, typename Typelist>
@@ -930,6 +1408,8 @@ struct convertible_type<T, nulltype>
     static constexpr type_index_t index = variant_npos;
 };
 
+#endif // variant_USES_FLAT_TYPELIST
+
 template <typename T, typename Typelist>
 struct value_traits
 {
@@ -1130,53 +1610,959 @@ inline std::size_t hash( T15 const & ) { return 0; }
 
 
 
-template< class T0, class T1, class T2, class T3, class T4, class T5, class T6, class T7, class T8, class T9, class T10, class T11, class T12, class T13, class T14, class T15 >
-struct helper
-{
-    typedef signed char type_index_t;
-    typedef variant_TL16( T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15 ) variant_types;
+// Dispatch run-time index in [Lo, Lo + Count) to op.template apply<K>(), with one switch
+// for up to variant_CONFIG_MAX_SWITCH_CASES indices and with a balanced binary search
+// over such switches for more. Only the Count real alternatives are instantiated; other
+// indices, such as that of a valueless variant, yield op.otherwise():
 
-    template< class U >
-    static U * as( void * data )
+template< std::size_t Lo, std::size_t Count, bool Split = ( Count > variant_CONFIG_MAX_SWITCH_CASES ) >
+struct index_switch
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
     {
-        return reinterpret_cast<U*>( data );
+        if ( index - Lo < Count / 2 )
+        {
+            return index_switch< Lo, Count / 2 >::apply( index, op );
+        }
+        return index_switch< Lo + Count / 2, Count - Count / 2 >::apply( index, op );
     }
+};
 
-    template< class U >
-    static U const * as( void const * data )
+template< std::size_t Lo >
+struct index_switch< Lo, 1, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
     {
-        return reinterpret_cast<const U*>( data );
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            default: return op.otherwise();
+        }
     }
+};
 
-    static type_index_t to_index_t( std::size_t index )
+template< std::size_t Lo >
+struct index_switch< Lo, 2, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
     {
-        return static_cast<type_index_t>( index );
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            default: return op.otherwise();
+        }
     }
+};
 
-    static void destroy( type_index_t index, void * data )
+template< std::size_t Lo >
+struct index_switch< Lo, 3, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+template< std::size_t Lo >
+struct index_switch< Lo, 4, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            case 3: return op.template apply< Lo + 3 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+template< std::size_t Lo >
+struct index_switch< Lo, 5, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            case 3: return op.template apply< Lo + 3 >();
+            case 4: return op.template apply< Lo + 4 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+template< std::size_t Lo >
+struct index_switch< Lo, 6, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            case 3: return op.template apply< Lo + 3 >();
+            case 4: return op.template apply< Lo + 4 >();
+            case 5: return op.template apply< Lo + 5 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+template< std::size_t Lo >
+struct index_switch< Lo, 7, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            case 3: return op.template apply< Lo + 3 >();
+            case 4: return op.template apply< Lo + 4 >();
+            case 5: return op.template apply< Lo + 5 >();
+            case 6: return op.template apply< Lo + 6 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+template< std::size_t Lo >
+struct index_switch< Lo, 8, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            case 3: return op.template apply< Lo + 3 >();
+            case 4: return op.template apply< Lo + 4 >();
+            case 5: return op.template apply< Lo + 5 >();
+            case 6: return op.template apply< Lo + 6 >();
+            case 7: return op.template apply< Lo + 7 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+template< std::size_t Lo >
+struct index_switch< Lo, 9, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            case 3: return op.template apply< Lo + 3 >();
+            case 4: return op.template apply< Lo + 4 >();
+            case 5: return op.template apply< Lo + 5 >();
+            case 6: return op.template apply< Lo + 6 >();
+            case 7: return op.template apply< Lo + 7 >();
+            case 8: return op.template apply< Lo + 8 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+template< std::size_t Lo >
+struct index_switch< Lo, 10, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            case 3: return op.template apply< Lo + 3 >();
+            case 4: return op.template apply< Lo + 4 >();
+            case 5: return op.template apply< Lo + 5 >();
+            case 6: return op.template apply< Lo + 6 >();
+            case 7: return op.template apply< Lo + 7 >();
+            case 8: return op.template apply< Lo + 8 >();
+            case 9: return op.template apply< Lo + 9 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+template< std::size_t Lo >
+struct index_switch< Lo, 11, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            case 3: return op.template apply< Lo + 3 >();
+            case 4: return op.template apply< Lo + 4 >();
+            case 5: return op.template apply< Lo + 5 >();
+            case 6: return op.template apply< Lo + 6 >();
+            case 7: return op.template apply< Lo + 7 >();
+            case 8: return op.template apply< Lo + 8 >();
+            case 9: return op.template apply< Lo + 9 >();
+            case 10: return op.template apply< Lo + 10 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+template< std::size_t Lo >
+struct index_switch< Lo, 12, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            case 3: return op.template apply< Lo + 3 >();
+            case 4: return op.template apply< Lo + 4 >();
+            case 5: return op.template apply< Lo + 5 >();
+            case 6: return op.template apply< Lo + 6 >();
+            case 7: return op.template apply< Lo + 7 >();
+            case 8: return op.template apply< Lo + 8 >();
+            case 9: return op.template apply< Lo + 9 >();
+            case 10: return op.template apply< Lo + 10 >();
+            case 11: return op.template apply< Lo + 11 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+template< std::size_t Lo >
+struct index_switch< Lo, 13, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            case 3: return op.template apply< Lo + 3 >();
+            case 4: return op.template apply< Lo + 4 >();
+            case 5: return op.template apply< Lo + 5 >();
+            case 6: return op.template apply< Lo + 6 >();
+            case 7: return op.template apply< Lo + 7 >();
+            case 8: return op.template apply< Lo + 8 >();
+            case 9: return op.template apply< Lo + 9 >();
+            case 10: return op.template apply< Lo + 10 >();
+            case 11: return op.template apply< Lo + 11 >();
+            case 12: return op.template apply< Lo + 12 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+template< std::size_t Lo >
+struct index_switch< Lo, 14, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            case 3: return op.template apply< Lo + 3 >();
+            case 4: return op.template apply< Lo + 4 >();
+            case 5: return op.template apply< Lo + 5 >();
+            case 6: return op.template apply< Lo + 6 >();
+            case 7: return op.template apply< Lo + 7 >();
+            case 8: return op.template apply< Lo + 8 >();
+            case 9: return op.template apply< Lo + 9 >();
+            case 10: return op.template apply< Lo + 10 >();
+            case 11: return op.template apply< Lo + 11 >();
+            case 12: return op.template apply< Lo + 12 >();
+            case 13: return op.template apply< Lo + 13 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+template< std::size_t Lo >
+struct index_switch< Lo, 15, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            case 3: return op.template apply< Lo + 3 >();
+            case 4: return op.template apply< Lo + 4 >();
+            case 5: return op.template apply< Lo + 5 >();
+            case 6: return op.template apply< Lo + 6 >();
+            case 7: return op.template apply< Lo + 7 >();
+            case 8: return op.template apply< Lo + 8 >();
+            case 9: return op.template apply< Lo + 9 >();
+            case 10: return op.template apply< Lo + 10 >();
+            case 11: return op.template apply< Lo + 11 >();
+            case 12: return op.template apply< Lo + 12 >();
+            case 13: return op.template apply< Lo + 13 >();
+            case 14: return op.template apply< Lo + 14 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+template< std::size_t Lo >
+struct index_switch< Lo, 16, false >
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        switch ( index - Lo )
+        {
+            case 0: return op.template apply< Lo + 0 >();
+            case 1: return op.template apply< Lo + 1 >();
+            case 2: return op.template apply< Lo + 2 >();
+            case 3: return op.template apply< Lo + 3 >();
+            case 4: return op.template apply< Lo + 4 >();
+            case 5: return op.template apply< Lo + 5 >();
+            case 6: return op.template apply< Lo + 6 >();
+            case 7: return op.template apply< Lo + 7 >();
+            case 8: return op.template apply< Lo + 8 >();
+            case 9: return op.template apply< Lo + 9 >();
+            case 10: return op.template apply< Lo + 10 >();
+            case 11: return op.template apply< Lo + 11 >();
+            case 12: return op.template apply< Lo + 12 >();
+            case 13: return op.template apply< Lo + 13 >();
+            case 14: return op.template apply< Lo + 14 >();
+            case 15: return op.template apply< Lo + 15 >();
+            default: return op.otherwise();
+        }
+    }
+};
+
+
+// Dispatch as index_switch, after testing index Likely with a branch hint, so that
+// the most frequent alternative avoids the indirect jump; no test if Likely is not
+// an index of the Count alternatives, see variant_CONFIG_LIKELY_INDEX:
+
+template< std::size_t Likely, std::size_t Count, bool Hint = ( Likely < Count ) >
+struct index_switch_likely
+{
+    template< class Op >
+    static variant_constexpr14 typename Op::result_type apply( std::size_t index, Op const & op )
+    {
+        if ( variant_likely( index == Likely ) )
+        {
+            return op.template apply< Likely >();
+        }
+        return index_switch< 0, Count >::apply( index, op );
+    }
+};
+
+template< std::size_t Likely, std::size_t Count >
+struct index_switch_likely< Likely, Count, false > : index_switch< 0, Count > {};
+
+#if variant_USES_SHARED_OPS
+
+// Destruction, copy and move of an alternative via void pointers, as functions shared
+// by all variants with that alternative, at any position. Trivially copyable
+// alternatives of the same size and alignment share the functions of their storage,
+// if they are copy- and move-constructible and -assignable; others keep their own,
+// so that an operation the alternative deletes remains a compile-time error:
+
+template< std::size_t Size, std::size_t Align >
+struct shared_storage
+{
+    alignas( Align ) unsigned char data[ Size ];
+};
+
+template< class T, bool Trivial = std::is_trivially_copyable<T>::value
+    && std::is_copy_constructible<T>::value && std::is_move_constructible<T>::value
+    && std::is_copy_assignable<T>::value && std::is_move_assignable<T>::value >
+struct shared_ops_key
+{
+    typedef T type;
+};
+
+template< class T >
+struct shared_ops_key< T, true >
+{
+    typedef shared_storage< sizeof( T ), alignof( T ) > type;
+};
+
+struct shared_valueless {};
+
+template< class T >
+struct shared_ops
+{
+    static void destroy( void * data )
+    {
+        static_cast< T * >( data )->~T();
+    }
+
+    static void copy_construct( void const * from, void * to )
+    {
+        new( to ) T( *static_cast< T const * >( from ) );
+    }
+
+    static void move_construct( void * from, void * to )
+    {
+        new( to ) T( std::move( *static_cast< T * >( from ) ) );
+    }
+
+    static void copy_assign( void const * from, void * to )
+    {
+        *static_cast< T * >( to ) = *static_cast< T const * >( from );
+    }
+
+    static void move_assign( void * from, void * to )
+    {
+        *static_cast< T * >( to ) = std::move( *static_cast< T * >( from ) );
+    }
+};
+
+template<>
+struct shared_ops< shared_valueless >
+{
+    static void destroy( void * ) {}
+    static void copy_construct( void const *, void * ) {}
+    static void move_construct( void *, void * ) {}
+    static void copy_assign( void const *, void * ) {}
+    static void move_assign( void *, void * ) {}
+};
+
+// the function of an operation for a key:
+
+struct shared_destroy
+{
+    typedef void ( * type )( void * );
+    template< class K > static constexpr type get() { return &shared_ops<K>::destroy; }
+};
+
+struct shared_copy_construct
+{
+    typedef void ( * type )( void const *, void * );
+    template< class K > static constexpr type get() { return &shared_ops<K>::copy_construct; }
+};
+
+struct shared_move_construct
+{
+    typedef void ( * type )( void *, void * );
+    template< class K > static constexpr type get() { return &shared_ops<K>::move_construct; }
+};
+
+struct shared_copy_assign
+{
+    typedef void ( * type )( void const *, void * );
+    template< class K > static constexpr type get() { return &shared_ops<K>::copy_assign; }
+};
+
+struct shared_move_assign
+{
+    typedef void ( * type )( void *, void * );
+    template< class K > static constexpr type get() { return &shared_ops<K>::move_assign; }
+};
+
+// Table of the functions of operation Op per index plus one, the first for a valueless
+// variant; constant-initialized, so that it is usable during static initialization:
+
+template< class Op, class T0, class T1, class T2, class T3, class T4, class T5, class T6, class T7, class T8, class T9, class T10, class T11, class T12, class T13, class T14, class T15 >
+struct shared_ops_table
+{
+    static constexpr typename Op::type value[ 17 ] =
+    {
+        Op::template get< shared_valueless >(),
+        Op::template get< typename shared_ops_key< T0 >::type >(),
+        Op::template get< typename shared_ops_key< T1 >::type >(),
+        Op::template get< typename shared_ops_key< T2 >::type >(),
+        Op::template get< typename shared_ops_key< T3 >::type >(),
+        Op::template get< typename shared_ops_key< T4 >::type >(),
+        Op::template get< typename shared_ops_key< T5 >::type >(),
+        Op::template get< typename shared_ops_key< T6 >::type >(),
+        Op::template get< typename shared_ops_key< T7 >::type >(),
+        Op::template get< typename shared_ops_key< T8 >::type >(),
+        Op::template get< typename shared_ops_key< T9 >::type >(),
+        Op::template get< typename shared_ops_key< T10 >::type >(),
+        Op::template get< typename shared_ops_key< T11 >::type >(),
+        Op::template get< typename shared_ops_key< T12 >::type >(),
+        Op::template get< typename shared_ops_key< T13 >::type >(),
+        Op::template get< typename shared_ops_key< T14 >::type >(),
+        Op::template get< typename shared_ops_key< T15 >::type >()
+    };
+};
+
+template< class Op, class T0, class T1, class T2, class T3, class T4, class T5, class T6, class T7, class T8, class T9, class T10, class T11, class T12, class T13, class T14, class T15 >
+constexpr typename Op::type shared_ops_table< Op, T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15 >::value[ 17 ];
+
+#endif // variant_USES_SHARED_OPS
+
+// Destruction, copy and move of the alternative at a run-time index, via one switch
+// that names the alternatives directly, so that dispatch costs no function
+// instantiation per alternative: a specialization for 1, 2, 4, 8... alternatives up
+// to variant_CONFIG_MAX_SWITCH_CASES, each used for variants with more than half as
+// many, whose switch also has cases for the unused parameters up to that number; a
+// variant with more uses index_switch. Switches over more than 8 alternatives
+// remain out of line, so that they do not grow every copy and assignment that uses
+// them. An index of a parameter that is not an alternative, such as npos, does nothing:
+
+template< class T0, class T1, class T2, class T3, class T4, class T5, class T6, class T7, class T8, class T9, class T10, class T11, class T12, class T13, class T14, class T15 >
+struct helper_switch
+{
+    typedef signed char type_index_t;
+
+    variant_noinline static void destroy( type_index_t index, void * data )
+    {
+        switch ( index )
+        {
+            case 0: static_cast< T0 * >( data )->~T0(); break;
+            case 1: static_cast< T1 * >( data )->~T1(); break;
+            case 2: static_cast< T2 * >( data )->~T2(); break;
+            case 3: static_cast< T3 * >( data )->~T3(); break;
+            case 4: static_cast< T4 * >( data )->~T4(); break;
+            case 5: static_cast< T5 * >( data )->~T5(); break;
+            case 6: static_cast< T6 * >( data )->~T6(); break;
+            case 7: static_cast< T7 * >( data )->~T7(); break;
+            case 8: static_cast< T8 * >( data )->~T8(); break;
+            case 9: static_cast< T9 * >( data )->~T9(); break;
+            case 10: static_cast< T10 * >( data )->~T10(); break;
+            case 11: static_cast< T11 * >( data )->~T11(); break;
+            case 12: static_cast< T12 * >( data )->~T12(); break;
+            case 13: static_cast< T13 * >( data )->~T13(); break;
+            case 14: static_cast< T14 * >( data )->~T14(); break;
+            case 15: static_cast< T15 * >( data )->~T15(); break;
+        }
+    }
+
+#if variant_CPP11_OR_GREATER
+    variant_noinline static void move_construct( type_index_t index, void * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: new( to ) T0( std::move( *static_cast< T0 * >( from ) ) ); break;
+            case 1: new( to ) T1( std::move( *static_cast< T1 * >( from ) ) ); break;
+            case 2: new( to ) T2( std::move( *static_cast< T2 * >( from ) ) ); break;
+            case 3: new( to ) T3( std::move( *static_cast< T3 * >( from ) ) ); break;
+            case 4: new( to ) T4( std::move( *static_cast< T4 * >( from ) ) ); break;
+            case 5: new( to ) T5( std::move( *static_cast< T5 * >( from ) ) ); break;
+            case 6: new( to ) T6( std::move( *static_cast< T6 * >( from ) ) ); break;
+            case 7: new( to ) T7( std::move( *static_cast< T7 * >( from ) ) ); break;
+            case 8: new( to ) T8( std::move( *static_cast< T8 * >( from ) ) ); break;
+            case 9: new( to ) T9( std::move( *static_cast< T9 * >( from ) ) ); break;
+            case 10: new( to ) T10( std::move( *static_cast< T10 * >( from ) ) ); break;
+            case 11: new( to ) T11( std::move( *static_cast< T11 * >( from ) ) ); break;
+            case 12: new( to ) T12( std::move( *static_cast< T12 * >( from ) ) ); break;
+            case 13: new( to ) T13( std::move( *static_cast< T13 * >( from ) ) ); break;
+            case 14: new( to ) T14( std::move( *static_cast< T14 * >( from ) ) ); break;
+            case 15: new( to ) T15( std::move( *static_cast< T15 * >( from ) ) ); break;
+        }
+    }
+
+    variant_noinline static void move_assign( type_index_t index, void * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: *static_cast< T0 * >( to ) = std::move( *static_cast< T0 * >( from ) ); break;
+            case 1: *static_cast< T1 * >( to ) = std::move( *static_cast< T1 * >( from ) ); break;
+            case 2: *static_cast< T2 * >( to ) = std::move( *static_cast< T2 * >( from ) ); break;
+            case 3: *static_cast< T3 * >( to ) = std::move( *static_cast< T3 * >( from ) ); break;
+            case 4: *static_cast< T4 * >( to ) = std::move( *static_cast< T4 * >( from ) ); break;
+            case 5: *static_cast< T5 * >( to ) = std::move( *static_cast< T5 * >( from ) ); break;
+            case 6: *static_cast< T6 * >( to ) = std::move( *static_cast< T6 * >( from ) ); break;
+            case 7: *static_cast< T7 * >( to ) = std::move( *static_cast< T7 * >( from ) ); break;
+            case 8: *static_cast< T8 * >( to ) = std::move( *static_cast< T8 * >( from ) ); break;
+            case 9: *static_cast< T9 * >( to ) = std::move( *static_cast< T9 * >( from ) ); break;
+            case 10: *static_cast< T10 * >( to ) = std::move( *static_cast< T10 * >( from ) ); break;
+            case 11: *static_cast< T11 * >( to ) = std::move( *static_cast< T11 * >( from ) ); break;
+            case 12: *static_cast< T12 * >( to ) = std::move( *static_cast< T12 * >( from ) ); break;
+            case 13: *static_cast< T13 * >( to ) = std::move( *static_cast< T13 * >( from ) ); break;
+            case 14: *static_cast< T14 * >( to ) = std::move( *static_cast< T14 * >( from ) ); break;
+            case 15: *static_cast< T15 * >( to ) = std::move( *static_cast< T15 * >( from ) ); break;
+        }
+    }
+#endif
+
+    variant_noinline static void copy_construct( type_index_t index, void const * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: new( to ) T0( *static_cast< T0 const * >( from ) ); break;
+            case 1: new( to ) T1( *static_cast< T1 const * >( from ) ); break;
+            case 2: new( to ) T2( *static_cast< T2 const * >( from ) ); break;
+            case 3: new( to ) T3( *static_cast< T3 const * >( from ) ); break;
+            case 4: new( to ) T4( *static_cast< T4 const * >( from ) ); break;
+            case 5: new( to ) T5( *static_cast< T5 const * >( from ) ); break;
+            case 6: new( to ) T6( *static_cast< T6 const * >( from ) ); break;
+            case 7: new( to ) T7( *static_cast< T7 const * >( from ) ); break;
+            case 8: new( to ) T8( *static_cast< T8 const * >( from ) ); break;
+            case 9: new( to ) T9( *static_cast< T9 const * >( from ) ); break;
+            case 10: new( to ) T10( *static_cast< T10 const * >( from ) ); break;
+            case 11: new( to ) T11( *static_cast< T11 const * >( from ) ); break;
+            case 12: new( to ) T12( *static_cast< T12 const * >( from ) ); break;
+            case 13: new( to ) T13( *static_cast< T13 const * >( from ) ); break;
+            case 14: new( to ) T14( *static_cast< T14 const * >( from ) ); break;
+            case 15: new( to ) T15( *static_cast< T15 const * >( from ) ); break;
+        }
+    }
+
+    variant_noinline static void copy_assign( type_index_t index, void const * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: *static_cast< T0 * >( to ) = *static_cast< T0 const * >( from ); break;
+            case 1: *static_cast< T1 * >( to ) = *static_cast< T1 const * >( from ); break;
+            case 2: *static_cast< T2 * >( to ) = *static_cast< T2 const * >( from ); break;
+            case 3: *static_cast< T3 * >( to ) = *static_cast< T3 const * >( from ); break;
+            case 4: *static_cast< T4 * >( to ) = *static_cast< T4 const * >( from ); break;
+            case 5: *static_cast< T5 * >( to ) = *static_cast< T5 const * >( from ); break;
+            case 6: *static_cast< T6 * >( to ) = *static_cast< T6 const * >( from ); break;
+            case 7: *static_cast< T7 * >( to ) = *static_cast< T7 const * >( from ); break;
+            case 8: *static_cast< T8 * >( to ) = *static_cast< T8 const * >( from ); break;
+            case 9: *static_cast< T9 * >( to ) = *static_cast< T9 const * >( from ); break;
+            case 10: *static_cast< T10 * >( to ) = *static_cast< T10 const * >( from ); break;
+            case 11: *static_cast< T11 * >( to ) = *static_cast< T11 const * >( from ); break;
+            case 12: *static_cast< T12 * >( to ) = *static_cast< T12 const * >( from ); break;
+            case 13: *static_cast< T13 * >( to ) = *static_cast< T13 const * >( from ); break;
+            case 14: *static_cast< T14 * >( to ) = *static_cast< T14 const * >( from ); break;
+            case 15: *static_cast< T15 * >( to ) = *static_cast< T15 const * >( from ); break;
+        }
+    }
+};
+
+template< class T0 >
+struct helper_switch< T0, detail::T1, detail::T2, detail::T3, detail::T4, detail::T5, detail::T6, detail::T7, detail::T8, detail::T9, detail::T10, detail::T11, detail::T12, detail::T13, detail::T14, detail::T15 >
+{
+    typedef signed char type_index_t;
+
+    static void destroy( type_index_t index, void * data )
+    {
+        switch ( index )
+        {
+            case 0: static_cast< T0 * >( data )->~T0(); break;
+        }
+    }
+
+#if variant_CPP11_OR_GREATER
+    static void move_construct( type_index_t index, void * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: new( to ) T0( std::move( *static_cast< T0 * >( from ) ) ); break;
+        }
+    }
+
+    static void move_assign( type_index_t index, void * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: *static_cast< T0 * >( to ) = std::move( *static_cast< T0 * >( from ) ); break;
+        }
+    }
+#endif
+
+    static void copy_construct( type_index_t index, void const * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: new( to ) T0( *static_cast< T0 const * >( from ) ); break;
+        }
+    }
+
+    static void copy_assign( type_index_t index, void const * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: *static_cast< T0 * >( to ) = *static_cast< T0 const * >( from ); break;
+        }
+    }
+};
+
+template< class T0, class T1 >
+struct helper_switch< T0, T1, detail::T2, detail::T3, detail::T4, detail::T5, detail::T6, detail::T7, detail::T8, detail::T9, detail::T10, detail::T11, detail::T12, detail::T13, detail::T14, detail::T15 >
+{
+    typedef signed char type_index_t;
+
+    static void destroy( type_index_t index, void * data )
+    {
+        switch ( index )
+        {
+            case 0: static_cast< T0 * >( data )->~T0(); break;
+            case 1: static_cast< T1 * >( data )->~T1(); break;
+        }
+    }
+
+#if variant_CPP11_OR_GREATER
+    static void move_construct( type_index_t index, void * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: new( to ) T0( std::move( *static_cast< T0 * >( from ) ) ); break;
+            case 1: new( to ) T1( std::move( *static_cast< T1 * >( from ) ) ); break;
+        }
+    }
+
+    static void move_assign( type_index_t index, void * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: *static_cast< T0 * >( to ) = std::move( *static_cast< T0 * >( from ) ); break;
+            case 1: *static_cast< T1 * >( to ) = std::move( *static_cast< T1 * >( from ) ); break;
+        }
+    }
+#endif
+
+    static void copy_construct( type_index_t index, void const * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: new( to ) T0( *static_cast< T0 const * >( from ) ); break;
+            case 1: new( to ) T1( *static_cast< T1 const * >( from ) ); break;
+        }
+    }
+
+    static void copy_assign( type_index_t index, void const * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: *static_cast< T0 * >( to ) = *static_cast< T0 const * >( from ); break;
+            case 1: *static_cast< T1 * >( to ) = *static_cast< T1 const * >( from ); break;
+        }
+    }
+};
+
+template< class T0, class T1, class T2, class T3 >
+struct helper_switch< T0, T1, T2, T3, detail::T4, detail::T5, detail::T6, detail::T7, detail::T8, detail::T9, detail::T10, detail::T11, detail::T12, detail::T13, detail::T14, detail::T15 >
+{
+    typedef signed char type_index_t;
+
+    static void destroy( type_index_t index, void * data )
+    {
+        switch ( index )
+        {
+            case 0: static_cast< T0 * >( data )->~T0(); break;
+            case 1: static_cast< T1 * >( data )->~T1(); break;
+            case 2: static_cast< T2 * >( data )->~T2(); break;
+            case 3: static_cast< T3 * >( data )->~T3(); break;
+        }
+    }
+
+#if variant_CPP11_OR_GREATER
+    static void move_construct( type_index_t index, void * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: new( to ) T0( std::move( *static_cast< T0 * >( from ) ) ); break;
+            case 1: new( to ) T1( std::move( *static_cast< T1 * >( from ) ) ); break;
+            case 2: new( to ) T2( std::move( *static_cast< T2 * >( from ) ) ); break;
+            case 3: new( to ) T3( std::move( *static_cast< T3 * >( from ) ) ); break;
+        }
+    }
+
+    static void move_assign( type_index_t index, void * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: *static_cast< T0 * >( to ) = std::move( *static_cast< T0 * >( from ) ); break;
+            case 1: *static_cast< T1 * >( to ) = std::move( *static_cast< T1 * >( from ) ); break;
+            case 2: *static_cast< T2 * >( to ) = std::move( *static_cast< T2 * >( from ) ); break;
+            case 3: *static_cast< T3 * >( to ) = std::move( *static_cast< T3 * >( from ) ); break;
+        }
+    }
+#endif
+
+    static void copy_construct( type_index_t index, void const * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: new( to ) T0( *static_cast< T0 const * >( from ) ); break;
+            case 1: new( to ) T1( *static_cast< T1 const * >( from ) ); break;
+            case 2: new( to ) T2( *static_cast< T2 const * >( from ) ); break;
+            case 3: new( to ) T3( *static_cast< T3 const * >( from ) ); break;
+        }
+    }
+
+    static void copy_assign( type_index_t index, void const * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: *static_cast< T0 * >( to ) = *static_cast< T0 const * >( from ); break;
+            case 1: *static_cast< T1 * >( to ) = *static_cast< T1 const * >( from ); break;
+            case 2: *static_cast< T2 * >( to ) = *static_cast< T2 const * >( from ); break;
+            case 3: *static_cast< T3 * >( to ) = *static_cast< T3 const * >( from ); break;
+        }
+    }
+};
+
+template< class T0, class T1, class T2, class T3, class T4, class T5, class T6, class T7 >
+struct helper_switch< T0, T1, T2, T3, T4, T5, T6, T7, detail::T8, detail::T9, detail::T10, detail::T11, detail::T12, detail::T13, detail::T14, detail::T15 >
+{
+    typedef signed char type_index_t;
+
+    static void destroy( type_index_t index, void * data )
+    {
+        switch ( index )
+        {
+            case 0: static_cast< T0 * >( data )->~T0(); break;
+            case 1: static_cast< T1 * >( data )->~T1(); break;
+            case 2: static_cast< T2 * >( data )->~T2(); break;
+            case 3: static_cast< T3 * >( data )->~T3(); break;
+            case 4: static_cast< T4 * >( data )->~T4(); break;
+            case 5: static_cast< T5 * >( data )->~T5(); break;
+            case 6: static_cast< T6 * >( data )->~T6(); break;
+            case 7: static_cast< T7 * >( data )->~T7(); break;
+        }
+    }
+
+#if variant_CPP11_OR_GREATER
+    static void move_construct( type_index_t index, void * from, void * to )
     {
         switch ( index )
         {
-        case 0: as<T0>( data )->~T0(); break;
-        case 1: as<T1>( data )->~T1(); break;
-        case 2: as<T2>( data )->~T2(); break;
-        case 3: as<T3>( data )->~T3(); break;
-        case 4: as<T4>( data )->~T4(); break;
-        case 5: as<T5>( data )->~T5(); break;
-        case 6: as<T6>( data )->~T6(); break;
-        case 7: as<T7>( data )->~T7(); break;
-        case 8: as<T8>( data )->~T8(); break;
-        case 9: as<T9>( data )->~T9(); break;
-        case 10: as<T10>( data )->~T10(); break;
-        case 11: as<T11>( data )->~T11(); break;
-        case 12: as<T12>( data )->~T12(); break;
-        case 13: as<T13>( data )->~T13(); break;
-        case 14: as<T14>( data )->~T14(); break;
-        case 15: as<T15>( data )->~T15(); break;
-        
+            case 0: new( to ) T0( std::move( *static_cast< T0 * >( from ) ) ); break;
+            case 1: new( to ) T1( std::move( *static_cast< T1 * >( from ) ) ); break;
+            case 2: new( to ) T2( std::move( *static_cast< T2 * >( from ) ) ); break;
+            case 3: new( to ) T3( std::move( *static_cast< T3 * >( from ) ) ); break;
+            case 4: new( to ) T4( std::move( *static_cast< T4 * >( from ) ) ); break;
+            case 5: new( to ) T5( std::move( *static_cast< T5 * >( from ) ) ); break;
+            case 6: new( to ) T6( std::move( *static_cast< T6 * >( from ) ) ); break;
+            case 7: new( to ) T7( std::move( *static_cast< T7 * >( from ) ) ); break;
+        }
+    }
+
+    static void move_assign( type_index_t index, void * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: *static_cast< T0 * >( to ) = std::move( *static_cast< T0 * >( from ) ); break;
+            case 1: *static_cast< T1 * >( to ) = std::move( *static_cast< T1 * >( from ) ); break;
+            case 2: *static_cast< T2 * >( to ) = std::move( *static_cast< T2 * >( from ) ); break;
+            case 3: *static_cast< T3 * >( to ) = std::move( *static_cast< T3 * >( from ) ); break;
+            case 4: *static_cast< T4 * >( to ) = std::move( *static_cast< T4 * >( from ) ); break;
+            case 5: *static_cast< T5 * >( to ) = std::move( *static_cast< T5 * >( from ) ); break;
+            case 6: *static_cast< T6 * >( to ) = std::move( *static_cast< T6 * >( from ) ); break;
+            case 7: *static_cast< T7 * >( to ) = std::move( *static_cast< T7 * >( from ) ); break;
+        }
+    }
+#endif
+
+    static void copy_construct( type_index_t index, void const * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: new( to ) T0( *static_cast< T0 const * >( from ) ); break;
+            case 1: new( to ) T1( *static_cast< T1 const * >( from ) ); break;
+            case 2: new( to ) T2( *static_cast< T2 const * >( from ) ); break;
+            case 3: new( to ) T3( *static_cast< T3 const * >( from ) ); break;
+            case 4: new( to ) T4( *static_cast< T4 const * >( from ) ); break;
+            case 5: new( to ) T5( *static_cast< T5 const * >( from ) ); break;
+            case 6: new( to ) T6( *static_cast< T6 const * >( from ) ); break;
+            case 7: new( to ) T7( *static_cast< T7 const * >( from ) ); break;
         }
     }
 
+    static void copy_assign( type_index_t index, void const * from, void * to )
+    {
+        switch ( index )
+        {
+            case 0: *static_cast< T0 * >( to ) = *static_cast< T0 const * >( from ); break;
+            case 1: *static_cast< T1 * >( to ) = *static_cast< T1 const * >( from ); break;
+            case 2: *static_cast< T2 * >( to ) = *static_cast< T2 const * >( from ); break;
+            case 3: *static_cast< T3 * >( to ) = *static_cast< T3 const * >( from ); break;
+            case 4: *static_cast< T4 * >( to ) = *static_cast< T4 const * >( from ); break;
+            case 5: *static_cast< T5 * >( to ) = *static_cast< T5 const * >( from ); break;
+            case 6: *static_cast< T6 * >( to ) = *static_cast< T6 const * >( from ); break;
+            case 7: *static_cast< T7 * >( to ) = *static_cast< T7 const * >( from ); break;
+        }
+    }
+};
+
+template< class T0, class T1, class T2, class T3, class T4, class T5, class T6, class T7, class T8, class T9, class T10, class T11, class T12, class T13, class T14, class T15 >
+struct helper
+{
+    typedef signed char type_index_t;
+    typedef variant_TL16( T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15 ) variant_types;
+
+    template< class U >
+    static U * as( void * data )
+    {
+        return reinterpret_cast<U*>( data );
+    }
+
+    template< class U >
+    static U const * as( void const * data )
+    {
+        return reinterpret_cast<const U*>( data );
+    }
+
+    static type_index_t to_index_t( std::size_t index )
+    {
+        return static_cast<type_index_t>( index );
+    }
+
+    static std::size_t to_size_t( type_index_t index )
+    {
+        return static_cast<std::size_t>( index );
+    }
+
+    typedef index_switch< 0, typelist_size< variant_types >::value > alternative_switch;
+    typedef helper_switch< T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15 > switch_type;
+
+    struct void_op
+    {
+        typedef void result_type;
+
+        void otherwise() const {}
+    };
+
+#if variant_USES_SHARED_OPS
+    template< class Op >
+    static typename Op::type shared( type_index_t index )
+    {
+        return shared_ops_table< Op, T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15 >::value[ static_cast<std::size_t>( index + 1 ) ];
+    }
+#endif
+
+    static void destroy( type_index_t index, void * data )
+    {
+#if variant_USES_SHARED_OPS
+        shared< shared_destroy >( index )( data );
+#else
+        switch_type::destroy( index, data );
+#endif
+    }
+
 #if variant_CPP11_OR_GREATER
     template< class T, class... Args >
     static type_index_t construct_t( void * data, Args&&... args )
@@ -1198,115 +2584,219 @@ struct helper
 
     static type_index_t move_construct( type_index_t const from_index, void * from_value, void * to_value )
     {
-        switch ( from_index )
-        {
-        case 0: new( to_value ) T0( std::move( *as<T0>( from_value ) ) ); break;
-        case 1: new( to_value ) T1( std::move( *as<T1>( from_value ) ) ); break;
-        case 2: new( to_value ) T2( std::move( *as<T2>( from_value ) ) ); break;
-        case 3: new( to_value ) T3( std::move( *as<T3>( from_value ) ) ); break;
-        case 4: new( to_value ) T4( std::move( *as<T4>( from_value ) ) ); break;
-        case 5: new( to_value ) T5( std::move( *as<T5>( from_value ) ) ); break;
-        case 6: new( to_value ) T6( std::move( *as<T6>( from_value ) ) ); break;
-        case 7: new( to_value ) T7( std::move( *as<T7>( from_value ) ) ); break;
-        case 8: new( to_value ) T8( std::move( *as<T8>( from_value ) ) ); break;
-        case 9: new( to_value ) T9( std::move( *as<T9>( from_value ) ) ); break;
-        case 10: new( to_value ) T10( std::move( *as<T10>( from_value ) ) ); break;
-        case 11: new( to_value ) T11( std::move( *as<T11>( from_value ) ) ); break;
-        case 12: new( to_value ) T12( std::move( *as<T12>( from_value ) ) ); break;
-        case 13: new( to_value ) T13( std::move( *as<T13>( from_value ) ) ); break;
-        case 14: new( to_value ) T14( std::move( *as<T14>( from_value ) ) ); break;
-        case 15: new( to_value ) T15( std::move( *as<T15>( from_value ) ) ); break;
-        
-        }
+#if variant_USES_SHARED_OPS
+        shared< shared_move_construct >( from_index )( from_value, to_value );
+#else
+        switch_type::move_construct( from_index, from_value, to_value );
+#endif
         return from_index;
     }
 
     static type_index_t move_assign( type_index_t const from_index, void * from_value, void * to_value )
     {
-        switch ( from_index )
-        {
-        case 0: *as<T0>( to_value ) = std::move( *as<T0>( from_value ) ); break;
-        case 1: *as<T1>( to_value ) = std::move( *as<T1>( from_value ) ); break;
-        case 2: *as<T2>( to_value ) = std::move( *as<T2>( from_value ) ); break;
-        case 3: *as<T3>( to_value ) = std::move( *as<T3>( from_value ) ); break;
-        case 4: *as<T4>( to_value ) = std::move( *as<T4>( from_value ) ); break;
-        case 5: *as<T5>( to_value ) = std::move( *as<T5>( from_value ) ); break;
-        case 6: *as<T6>( to_value ) = std::move( *as<T6>( from_value ) ); break;
-        case 7: *as<T7>( to_value ) = std::move( *as<T7>( from_value ) ); break;
-        case 8: *as<T8>( to_value ) = std::move( *as<T8>( from_value ) ); break;
-        case 9: *as<T9>( to_value ) = std::move( *as<T9>( from_value ) ); break;
-        case 10: *as<T10>( to_value ) = std::move( *as<T10>( from_value ) ); break;
-        case 11: *as<T11>( to_value ) = std::move( *as<T11>( from_value ) ); break;
-        case 12: *as<T12>( to_value ) = std::move( *as<T12>( from_value ) ); break;
-        case 13: *as<T13>( to_value ) = std::move( *as<T13>( from_value ) ); break;
-        case 14: *as<T14>( to_value ) = std::move( *as<T14>( from_value ) ); break;
-        case 15: *as<T15>( to_value ) = std::move( *as<T15>( from_value ) ); break;
-        
-        }
+#if variant_USES_SHARED_OPS
+        shared< shared_move_assign >( from_index )( from_value, to_value );
+#else
+        switch_type::move_assign( from_index, from_value, to_value );
+#endif
         return from_index;
     }
 #endif
 
     static type_index_t copy_construct( type_index_t const from_index, const void * from_value, void * to_value )
     {
-        switch ( from_index )
-        {
-        case 0: new( to_value ) T0( *as<T0>( from_value ) ); break;
-        case 1: new( to_value ) T1( *as<T1>( from_value ) ); break;
-        case 2: new( to_value ) T2( *as<T2>( from_value ) ); break;
-        case 3: new( to_value ) T3( *as<T3>( from_value ) ); break;
-        case 4: new( to_value ) T4( *as<T4>( from_value ) ); break;
-        case 5: new( to_value ) T5( *as<T5>( from_value ) ); break;
-        case 6: new( to_value ) T6( *as<T6>( from_value ) ); break;
-        case 7: new( to_value ) T7( *as<T7>( from_value ) ); break;
-        case 8: new( to_value ) T8( *as<T8>( from_value ) ); break;
-        case 9: new( to_value ) T9( *as<T9>( from_value ) ); break;
-        case 10: new( to_value ) T10( *as<T10>( from_value ) ); break;
-        case 11: new( to_value ) T11( *as<T11>( from_value ) ); break;
-        case 12: new( to_value ) T12( *as<T12>( from_value ) ); break;
-        case 13: new( to_value ) T13( *as<T13>( from_value ) ); break;
-        case 14: new( to_value ) T14( *as<T14>( from_value ) ); break;
-        case 15: new( to_value ) T15( *as<T15>( from_value ) ); break;
-        
-        }
+#if variant_USES_SHARED_OPS
+        shared< shared_copy_construct >( from_index )( from_value, to_value );
+#else
+        switch_type::copy_construct( from_index, from_value, to_value );
+#endif
         return from_index;
     }
 
     static type_index_t copy_assign( type_index_t const from_index, const void * from_value, void * to_value )
     {
-        switch ( from_index )
-        {
-        case 0: *as<T0>( to_value ) = *as<T0>( from_value ); break;
-        case 1: *as<T1>( to_value ) = *as<T1>( from_value ); break;
-        case 2: *as<T2>( to_value ) = *as<T2>( from_value ); break;
-        case 3: *as<T3>( to_value ) = *as<T3>( from_value ); break;
-        case 4: *as<T4>( to_value ) = *as<T4>( from_value ); break;
-        case 5: *as<T5>( to_value ) = *as<T5>( from_value ); break;
-        case 6: *as<T6>( to_value ) = *as<T6>( from_value ); break;
-        case 7: *as<T7>( to_value ) = *as<T7>( from_value ); break;
-        case 8: *as<T8>( to_value ) = *as<T8>( from_value ); break;
-        case 9: *as<T9>( to_value ) = *as<T9>( from_value ); break;
-        case 10: *as<T10>( to_value ) = *as<T10>( from_value ); break;
-        case 11: *as<T11>( to_value ) = *as<T11>( from_value ); break;
-        case 12: *as<T12>( to_value ) = *as<T12>( from_value ); break;
-        case 13: *as<T13>( to_value ) = *as<T13>( from_value ); break;
-        case 14: *as<T14>( to_value ) = *as<T14>( from_value ); break;
-        case 15: *as<T15>( to_value ) = *as<T15>( from_value ); break;
-        
-        }
+#if variant_USES_SHARED_OPS
+        shared< shared_copy_assign >( from_index )( from_value, to_value );
+#else
+        switch_type::copy_assign( from_index, from_value, to_value );
+#endif
         return from_index;
     }
 };
 
+#if variant_USES_UNION_STORAGE
+
+// Storage of the alternatives in a recursive union: the variant constructs and accesses
+// an alternative as union member, so that a variant of literal types can be created,
+// copied, assigned and compared in constant expressions. Unused template parameters
+// are empty members, as get<K>() remains valid for them:
+
+template< class List, template< class > class Predicate >
+struct typelist_all : std::true_type {};
+
+template< class Head, class Tail, template< class > class Predicate >
+struct typelist_all< typelist<Head, Tail>, Predicate >
+    : std::integral_constant< bool, Predicate<Head>::value && typelist_all<Tail, Predicate>::value > {};
+
+template< class List, bool Trivial = typelist_all< List, std::is_trivially_destructible >::value >
+union variant_union;
+
+template< bool Trivial >
+union variant_union< nulltype, Trivial > {};
+
+template< class Head, class Tail >
+union variant_union< typelist<Head, Tail>, true >
+{
+    Head head;
+    variant_union< Tail > tail;
+
+    variant_constexpr variant_union() variant_noexcept
+    : tail() {}
+
+    template< class... Args >
+    variant_constexpr explicit variant_union( index_tag_t<0>, Args&&... args )
+    : head( std::forward<Args>(args)... ) {}
+
+    template< std::size_t K, class... Args >
+    variant_constexpr explicit variant_union( index_tag_t<K>, Args&&... args )
+    : tail( index_tag_t<K - 1>(), std::forward<Args>(args)... ) {}
+};
+
+template< class Head, class Tail >
+union variant_union< typelist<Head, Tail>, false >
+{
+    Head head;
+    variant_union< Tail > tail;
+
+    variant_constexpr variant_union() variant_noexcept
+    : tail() {}
+
+    template< class... Args >
+    variant_constexpr explicit variant_union( index_tag_t<0>, Args&&... args )
+    : head( std::forward<Args>(args)... ) {}
+
+    template< std::size_t K, class... Args >
+    variant_constexpr explicit variant_union( index_tag_t<K>, Args&&... args )
+    : tail( index_tag_t<K - 1>(), std::forward<Args>(args)... ) {}
+
+    // the variant destroys the active member:
+
+    ~variant_union() {}
+};
+
+template< std::size_t K >
+struct union_member
+{
+    template< class Union >
+    static variant_constexpr auto get( Union & u ) -> decltype( union_member<K - 1>::get( u.tail ) )
+    {
+        return union_member<K - 1>::get( u.tail );
+    }
+};
+
+template<>
+struct union_member< 0 >
+{
+    template< class Union >
+    static variant_constexpr auto get( Union & u ) -> decltype( ( u.head ) )
+    {
+        return u.head;
+    }
+};
+
+// union and index; trivially destructible if all alternatives are:
+
+template< class Helper, bool Trivial = typelist_all< typename Helper::variant_types, std::is_trivially_destructible >::value >
+struct variant_storage
+{
+    typedef typename Helper::type_index_t type_index_t;
+
+    variant_union< typename Helper::variant_types > data;
+    type_index_t type_index;
+
+    // no active alternative:
+
+    variant_constexpr explicit variant_storage( type_index_t index ) variant_noexcept
+    : data(), type_index( index ) {}
+
+    template< std::size_t K, class... Args >
+    variant_constexpr explicit variant_storage( index_tag_t<K>, Args&&... args )
+    : data( index_tag_t<K>(), std::forward<Args>(args)... ), type_index( static_cast<type_index_t>( K ) ) {}
+};
+
+template< class Helper >
+struct variant_storage< Helper, false > : variant_storage< Helper, true >
+{
+    using variant_storage< Helper, true >::variant_storage;
+
+    ~variant_storage()
+    {
+        if ( this->type_index != static_cast<typename Helper::type_index_t>( -1 ) )
+        {
+            Helper::destroy( this->type_index, &this->data );
+        }
+    }
+};
+
+#endif // variant_USES_UNION_STORAGE
+
 } // namespace detail
 
 //
 // Variant:
 //
 
-template< class T0, class T1, class T2, class T3, class T4, class T5, class T6, class T7, class T8, class T9, class T10, class T11, class T12, class T13, class T14, class T15 >
+// variant with its default template arguments, also in nonstd/variant_fwd.hpp;
+// default template arguments can be given only once:
+
+#ifndef NONSTD_VARIANT_LITE_FWD_DECLARATIONS
+#define NONSTD_VARIANT_LITE_FWD_DECLARATIONS
+
+namespace detail {
+
+template< class T > struct TX;
+
+struct S0; typedef TX<S0> T0;
+struct S1; typedef TX<S1> T1;
+struct S2; typedef TX<S2> T2;
+struct S3; typedef TX<S3> T3;
+struct S4; typedef TX<S4> T4;
+struct S5; typedef TX<S5> T5;
+struct S6; typedef TX<S6> T6;
+struct S7; typedef TX<S7> T7;
+struct S8; typedef TX<S8> T8;
+struct S9; typedef TX<S9> T9;
+struct S10; typedef TX<S10> T10;
+struct S11; typedef TX<S11> T11;
+struct S12; typedef TX<S12> T12;
+struct S13; typedef TX<S13> T13;
+struct S14; typedef TX<S14> T14;
+struct S15; typedef TX<S15> T15;
+
+} // namespace detail
+
+template<
+    class T0,
+    class T1 = detail::T1,
+    class T2 = detail::T2,
+    class T3 = detail::T3,
+    class T4 = detail::T4,
+    class T5 = detail::T5,
+    class T6 = detail::T6,
+    class T7 = detail::T7,
+    class T8 = detail::T8,
+    class T9 = detail::T9,
+    class T10 = detail::T10,
+    class T11 = detail::T11,
+    class T12 = detail::T12,
+    class T13 = detail::T13,
+    class T14 = detail::T14,
+    class T15 = detail::T15
+    >
 class variant;
 
+#endif // NONSTD_VARIANT_LITE_FWD_DECLARATIONS
+
 // 19.7.8 Class monostate
 
 #ifdef variant_CONFIG_OVERRIDE_MONOSTATE
@@ -1399,30 +2889,205 @@ public:
 
 #endif // variant_CONFIG_NO_EXCEPTIONS
 
-// 19.7.3 Class template variant
+#if variant_USES_PROFILE
 
-template<
-    class T0,
-    class T1 = detail::T1,
-    class T2 = detail::T2,
-    class T3 = detail::T3,
-    class T4 = detail::T4,
-    class T5 = detail::T5,
-    class T6 = detail::T6,
-    class T7 = detail::T7,
-    class T8 = detail::T8,
-    class T9 = detail::T9,
-    class T10 = detail::T10,
-    class T11 = detail::T11,
-    class T12 = detail::T12,
-    class T13 = detail::T13,
-    class T14 = detail::T14,
-    class T15 = detail::T15
-    >
+namespace detail {
+
+// Operation counters per variant type and alternative, see variant_CONFIG_PROFILE.
+// Each thread increments counters of its own without synchronization; the counters
+// of all threads, including those that ended, are summed on request:
+
+enum profile_event
+{
+    profile_construct,
+    profile_copy,
+    profile_move,
+    profile_emplace,
+    profile_visit,
+    profile_bad_access,
+    profile_event_count
+};
+
+typedef unsigned long long profile_counts[ profile_event_count ][ variant_CONFIG_MAX_TYPE_COUNT ];
+
+struct profile_block
+{
+    profile_block * next;
+    std::atomic< unsigned long long > count[ profile_event_count ][ variant_CONFIG_MAX_TYPE_COUNT ];
+
+    profile_block() : next( variant_nullptr ), count() {}
+
+    void add_to( profile_counts & total ) const
+    {
+        for ( std::size_t e = 0; e != profile_event_count; ++e )
+        {
+            for ( std::size_t k = 0; k != variant_CONFIG_MAX_TYPE_COUNT; ++k )
+            {
+                total[e][k] += count[e][k].load( std::memory_order_relaxed );
+            }
+        }
+    }
+};
+
+// variant types that have been counted, for a report of all of them:
+
+struct profile_type
+{
+    profile_type * next;
+    char const * name;
+    std::size_t size;
+    void ( * merge )( profile_counts & total );
+};
+
+struct profile_type_list
+{
+    std::mutex mutex;
+    profile_type * head;
+
+    profile_type_list() : head( variant_nullptr ) {}
+
+    static profile_type_list & instance()
+    {
+        static profile_type_list list;
+        return list;
+    }
+};
+
+template< class Variant >
+class profile
+{
+public:
+    // index of a valueless variant is not counted:
+
+    static void count( profile_event event, std::size_t index )
+    {
+        if ( index < variant_CONFIG_MAX_TYPE_COUNT )
+        {
+            std::atomic< unsigned long long > & counter = local().count[ event ][ index ];
+            counter.store( counter.load( std::memory_order_relaxed ) + 1, std::memory_order_relaxed );
+        }
+    }
+
+    static char const * name()
+    {
+        return instance().type.name;
+    }
+
+    static void merge( profile_counts & total )
+    {
+        shared & s = instance();
+        std::lock_guard< std::mutex > lock( s.mutex );
+
+        s.ended.add_to( total );
+
+        for ( profile_block const * block = s.threads; block; block = block->next )
+        {
+            block->add_to( total );
+        }
+    }
+
+private:
+    struct shared
+    {
+        std::mutex mutex;
+        profile_block * threads;
+        profile_block ended;
+        profile_type type;
+
+        shared() : threads( variant_nullptr )
+        {
+#if defined( __cpp_rtti ) || defined( __GXX_RTTI ) || defined( _CPPRTTI )
+            char const * const name = typeid( Variant ).name();
+#else
+            char const * const name = "variant";
+#endif
+            profile_type const t = { variant_nullptr, name, variant_size< Variant >::value, &profile::merge };
+            type = t;
+
+            profile_type_list & list = profile_type_list::instance();
+            std::lock_guard< std::mutex > lock( list.mutex );
+            type.next = list.head;
+            list.head = &type;
+        }
+    };
+
+    // the counters of the calling thread, added to those of ended threads at its end:
+
+    struct thread_block : profile_block
+    {
+        thread_block()
+        {
+            shared & s = instance();
+            std::lock_guard< std::mutex > lock( s.mutex );
+            next = s.threads;
+            s.threads = this;
+        }
+
+        ~thread_block()
+        {
+            shared & s = instance();
+            std::lock_guard< std::mutex > lock( s.mutex );
+
+            profile_block ** link = &s.threads;
+            while ( *link != this )
+            {
+                link = &( *link )->next;
+            }
+            *link = next;
+
+            profile_counts counts = {};
+            add_to( counts );
+
+            for ( std::size_t e = 0; e != profile_event_count; ++e )
+            {
+                for ( std::size_t k = 0; k != variant_CONFIG_MAX_TYPE_COUNT; ++k )
+                {
+                    s.ended.count[e][k].fetch_add( counts[e][k], std::memory_order_relaxed );
+                }
+            }
+        }
+    };
+
+    static shared & instance()
+    {
+        static shared s;
+        return s;
+    }
+
+    static profile_block & local()
+    {
+        static thread_local thread_block block;
+        return block;
+    }
+};
+
+template< class Variant >
+inline void profile_count( profile_event event, Variant const &, std::size_t index )
+{
+    profile< Variant >::count( event, index );
+}
+
+} // namespace detail
+
+# define variant_PROFILE( event, v, index )  detail::profile_count( detail::profile_##event, v, index )
+#else
+# define variant_PROFILE( event, v, index )
+#endif // variant_USES_PROFILE
+
+// 19.7.3 Class template variant
+
+template< class T0, class T1, class T2, class T3, class T4, class T5, class T6, class T7, class T8, class T9, class T10, class T11, class T12, class T13, class T14, class T15 >
 class variant
+#if variant_USES_UNION_STORAGE
+    : private detail::variant_storage< detail::helper< T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15 > >
+#endif
 {
     typedef detail::helper< T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15 > helper_type;
     typedef variant_TL16( T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15 ) variant_types;
+#if variant_USES_UNION_STORAGE
+    typedef detail::variant_storage< helper_type > storage_type;
+    typedef detail::typelist_all< variant_types, std::is_trivially_copyable > trivially_copyable;
+#endif
 
 #if variant_CPP11_OR_GREATER
     variant_STATIC_ASSERT( detail::typelist_size<variant_types>::value > 0, "Template parameter type list of variant can not be empty.");
@@ -1434,13 +3099,20 @@ class variant
 public:
     // 19.7.3.1 Constructors
 
-    variant() variant_noexcept_op( std::is_nothrow_default_constructible<T0>::value )
+    variant_constexpr_union variant() variant_noexcept_op( std::is_nothrow_default_constructible<T0>::value )
+#if variant_USES_UNION_STORAGE
+    : storage_type( detail::index_tag_t<0>() )
+#else
     : type_index( 0 )
+#endif
     {
 #if variant_CPP11_OR_GREATER
         variant_STATIC_ASSERT( std::is_default_constructible<T0>::value, "First type in variant must be default constructible to allow default construction of variant (e.g. use monostate).");
 #endif
+#if ! variant_USES_UNION_STORAGE
         new( ptr() ) T0();
+#endif
+        variant_PROFILE( construct, *this, 0 );
     }
 
 #if variant_CPP11_OR_GREATER
@@ -1471,25 +3143,46 @@ public:
     template < typename T, typename Traits = detail::value_traits<T, variant_types>
         variant_REQUIRES_B( Traits::is_valid && !std::is_same<variant<variant_types>, typename Traits::value_type>::value )
     >
-    variant( T && t ) noexcept( std::is_nothrow_constructible<typename Traits::target_type, T&&>::value )
+    variant_constexpr_union variant( T && t ) noexcept( std::is_nothrow_constructible<typename Traits::target_type, T&&>::value )
+#if variant_USES_UNION_STORAGE
+        : storage_type( detail::index_tag_t<Traits::list_index>(), std::forward<T>( t ) )
+    {
+        variant_PROFILE( construct, *this, Traits::list_index );
+    }
+#else
         : type_index( Traits::list_index )
     {
         new( ptr() ) typename Traits::target_type( std::forward<T>( t ) );
+        variant_PROFILE( construct, *this, Traits::list_index );
     }
+#endif
 
 #endif // variant_CPP11_OR_GREATER
 
     // This function shall not participate in overload resolution unless is_copy_constructible_v<T_i> is true for all i.
 
+#if variant_USES_UNION_STORAGE
+
+    variant_constexpr_union variant( variant const & other )
+    : variant( other, trivially_copyable() )
+    {
+        variant_PROFILE( copy, *this, other.index() );
+    }
+
+#else
+
     variant(variant const & other)
     : type_index( variant_npos_internal() )
     {
         type_index = helper_type::copy_construct( other.type_index, other.ptr(), ptr() );
+        variant_PROFILE( copy, *this, other.index() );
     }
 
+#endif
+
 #if variant_CPP11_OR_GREATER
 
-    variant( variant && other ) noexcept(
+    variant_constexpr_union variant( variant && other ) noexcept(
         std::is_nothrow_move_constructible<T0>::value &&
         std::is_nothrow_move_constructible<T1>::value &&
         std::is_nothrow_move_constructible<T2>::value &&
@@ -1506,10 +3199,18 @@ public:
         std::is_nothrow_move_constructible<T13>::value &&
         std::is_nothrow_move_constructible<T14>::value &&
         std::is_nothrow_move_constructible<T15>::value)
-        : type_index( variant_npos_internal() )
+        #if variant_USES_UNION_STORAGE
+    : variant( std::move( other ), trivially_copyable() )
+    {
+        variant_PROFILE( move, *this, other.index() );
+    }
+#else
+    : type_index( variant_npos_internal() )
     {
         type_index = helper_type::move_construct( other.type_index, other.ptr(), ptr() );
+        variant_PROFILE( move, *this, other.index() );
     }
+#endif
 
     template< std::size_t K >
     using type_at_t = typename detail::typelist_type_at< variant_types, K >::type;
@@ -1517,43 +3218,78 @@ public:
     template< class T, class... Args
         variant_REQUIRES_T( std::is_constructible< T, Args...>::value )
     >
-    explicit variant( nonstd_lite_in_place_type_t(T), Args&&... args)
+    explicit variant_constexpr_union variant( nonstd_lite_in_place_type_t(T), Args&&... args)
+#if variant_USES_UNION_STORAGE
+    : storage_type( detail::index_tag_t<index_of<T>()>(), std::forward<Args>(args)... )
+    {
+        variant_PROFILE( construct, *this, index_of<T>() );
+    }
+#else
     {
         type_index = variant_npos_internal();
         type_index = helper_type::template construct_t<T>( ptr(), std::forward<Args>(args)... );
+        variant_PROFILE( construct, *this, index() );
     }
+#endif
 
     template< class T, class U, class... Args
         variant_REQUIRES_T( std::is_constructible< T, std::initializer_list<U>&, Args...>::value )
     >
-    explicit variant( nonstd_lite_in_place_type_t(T), std::initializer_list<U> il, Args&&... args )
+    explicit variant_constexpr_union variant( nonstd_lite_in_place_type_t(T), std::initializer_list<U> il, Args&&... args )
+#if variant_USES_UNION_STORAGE
+    : storage_type( detail::index_tag_t<index_of<T>()>(), il, std::forward<Args>(args)... )
+    {
+        variant_PROFILE( construct, *this, index_of<T>() );
+    }
+#else
     {
         type_index = variant_npos_internal();
         type_index = helper_type::template construct_t<T>( ptr(), il, std::forward<Args>(args)... );
+        variant_PROFILE( construct, *this, index() );
     }
+#endif
 
     template< std::size_t K, class... Args
         variant_REQUIRES_T( std::is_constructible< type_at_t<K>, Args...>::value )
     >
-    explicit variant( nonstd_lite_in_place_index_t(K), Args&&... args )
+    explicit variant_constexpr_union variant( nonstd_lite_in_place_index_t(K), Args&&... args )
+#if variant_USES_UNION_STORAGE
+    : storage_type( detail::index_tag_t<K>(), std::forward<Args>(args)... )
+    {
+        variant_PROFILE( construct, *this, K );
+    }
+#else
     {
         type_index = variant_npos_internal();
         type_index = helper_type::template construct_i<K>( ptr(), std::forward<Args>(args)... );
+        variant_PROFILE( construct, *this, index() );
     }
+#endif
 
     template< size_t K, class U, class... Args
         variant_REQUIRES_T( std::is_constructible< type_at_t<K>, std::initializer_list<U>&, Args...>::value )
     >
-    explicit variant( nonstd_lite_in_place_index_t(K), std::initializer_list<U> il, Args&&... args )
+    explicit variant_constexpr_union variant( nonstd_lite_in_place_index_t(K), std::initializer_list<U> il, Args&&... args )
+#if variant_USES_UNION_STORAGE
+    : storage_type( detail::index_tag_t<K>(), il, std::forward<Args>(args)... )
+    {
+        variant_PROFILE( construct, *this, K );
+    }
+#else
     {
         type_index = variant_npos_internal();
         type_index = helper_type::template construct_i<K>( ptr(), il, std::forward<Args>(args)... );
+        variant_PROFILE( construct, *this, index() );
     }
+#endif
 
 #endif // variant_CPP11_OR_GREATER
 
     // 19.7.3.2 Destructor
 
+#if ! variant_USES_UNION_STORAGE
+    // with union storage, the storage destroys the alternative:
+
     ~variant()
     {
         if ( ! valueless_by_exception() )
@@ -1561,17 +3297,19 @@ public:
             helper_type::destroy( type_index, ptr() );
         }
     }
+#endif
 
     // 19.7.3.3 Assignment
 
-    variant & operator=( variant const & other )
+    variant_constexpr14_union variant & operator=( variant const & other )
     {
+        variant_PROFILE( copy, *this, other.index() );
         return copy_assign( other );
     }
 
 #if variant_CPP11_OR_GREATER
 
-    variant & operator=( variant && other ) noexcept(
+    variant_constexpr14_union variant & operator=( variant && other ) noexcept(
         std::is_nothrow_move_constructible<T0>::value && std::is_nothrow_move_assignable<T0>::value &&
         std::is_nothrow_move_constructible<T1>::value && std::is_nothrow_move_assignable<T1>::value &&
         std::is_nothrow_move_constructible<T2>::value && std::is_nothrow_move_assignable<T2>::value &&
@@ -1589,18 +3327,18 @@ public:
         std::is_nothrow_move_constructible<T14>::value && std::is_nothrow_move_assignable<T14>::value &&
         std::is_nothrow_move_constructible<T15>::value && std::is_nothrow_move_assignable<T15>::value)
         {
+        variant_PROFILE( move, *this, other.index() );
         return move_assign( std::move( other ) );
     }
 
     template < typename T, typename Traits = detail::value_traits<T, variant_types>
         variant_REQUIRES_B( Traits::is_valid && !std::is_same<variant<variant_types>, typename Traits::value_type>::value )
     >
-    variant & operator=( T && t ) noexcept(
+    variant_constexpr14_union variant & operator=( T && t ) noexcept(
             std::is_nothrow_constructible<typename Traits::target_type,T&&>::value
             && std::is_nothrow_assignable<typename Traits::target_type,T&&>::value )
     {
-        type_index = variant_npos_internal();
-        return move_assign( std::move( variant( std::forward<T>( t ) ) ) );
+        return assign_value< Traits::list_index, typename Traits::target_type >( std::forward<T>( t ) );
     }
 
 #endif //variant_CPP11_OR_GREATER
@@ -1638,11 +3376,12 @@ public:
     >
     T& emplace( Args&&... args )
     {
+        variant_PROFILE( emplace, *this, index_of<T>() );
         helper_type::destroy( type_index, ptr() );
         type_index = variant_npos_internal();
         type_index = helper_type::template construct_t<T>( ptr(), std::forward<Args>(args)... );
 
-        return *as<T>();
+        return alternative<T>();
     }
 
     template< class T, class U, class... Args
@@ -1651,11 +3390,12 @@ public:
     >
     T& emplace( std::initializer_list<U> il, Args&&... args )
     {
+        variant_PROFILE( emplace, *this, index_of<T>() );
         helper_type::destroy( type_index, ptr() );
         type_index = variant_npos_internal();
         type_index = helper_type::template construct_t<T>( ptr(), il, std::forward<Args>(args)... );
 
-        return *as<T>();
+        return alternative<T>();
     }
 
     template< size_t K, class... Args
@@ -1746,42 +3486,44 @@ public:
     }
 
     template< class T >
-    T & get()
+    variant_constexpr14_union T & get()
     {
 #if variant_CONFIG_NO_EXCEPTIONS
         assert( index_of<T>() == index() );
 #else
         if ( index_of<T>() != index() )
         {
+            variant_PROFILE( bad_access, *this, index_of<T>() );
             throw bad_variant_access();
         }
 #endif
-        return *as<T>();
+        return alternative<T>();
     }
 
     template< class T >
-    T const & get() const
+    variant_constexpr14_union T const & get() const
     {
 #if variant_CONFIG_NO_EXCEPTIONS
         assert( index_of<T>() == index() );
 #else
         if ( index_of<T>() != index() )
         {
+            variant_PROFILE( bad_access, *this, index_of<T>() );
             throw bad_variant_access();
         }
 #endif
-        return *as<const T>();
+        return alternative<T>();
     }
 
     template< std::size_t K >
-    typename variant_alternative< K, variant >::type &
+    variant_constexpr14_union typename variant_alternative< K, variant >::type &
     get()
     {
         return this->template get< typename detail::typelist_type_at< variant_types, K >::type >();
     }
 
     template< std::size_t K >
-    typename variant_alternative< K, variant >::type const &
+    variant_constexpr14_union typename variant_alternative< K, variant >::type const &
     get() const
     {
         return this->template get< typename detail::typelist_type_at< variant_types, K >::type >();
@@ -1790,6 +3532,48 @@ public:
 private:
     typedef typename helper_type::type_index_t type_index_t;
 
+#if variant_USES_UNION_STORAGE
+    using storage_type::data;
+    using storage_type::type_index;
+
+    // trivially copyable alternatives: copy union and index as a whole:
+
+    variant_constexpr variant( variant const & other, std::true_type )
+    : storage_type( other ) {}
+
+    variant( variant const & other, std::false_type )
+    : storage_type( variant_npos_internal() )
+    {
+        type_index = helper_type::copy_construct( other.type_index, other.ptr(), ptr() );
+    }
+
+    variant( variant && other, std::false_type )
+    : storage_type( variant_npos_internal() )
+    {
+        type_index = helper_type::move_construct( other.type_index, other.ptr(), ptr() );
+    }
+#endif
+
+    template< class U >
+    variant_constexpr14_union U & alternative()
+    {
+#if variant_USES_UNION_STORAGE
+        return detail::union_member< index_of<U>() >::get( data );
+#else
+        return *as<U>();
+#endif
+    }
+
+    template< class U >
+    variant_constexpr_union U const & alternative() const
+    {
+#if variant_USES_UNION_STORAGE
+        return detail::union_member< index_of<U>() >::get( data );
+#else
+        return *as<U const>();
+#endif
+    }
+
     void * ptr() variant_noexcept
     {
         return &data;
@@ -1823,7 +3607,22 @@ private:
         return static_cast<type_index_t>( -1 );
     }
 
+#if variant_USES_UNION_STORAGE
+    variant_constexpr14 variant & copy_assign( variant const & other )
+    {
+        return copy_assign( other, trivially_copyable() );
+    }
+
+    variant_constexpr14 variant & copy_assign( variant const & other, std::true_type )
+    {
+        static_cast< storage_type & >( *this ) = other;
+        return *this;
+    }
+
+    variant & copy_assign( variant const & other, std::false_type )
+#else
     variant & copy_assign( variant const & other )
+#endif
     {
         if ( valueless_by_exception() && other.valueless_by_exception() )
         {
@@ -1849,7 +3648,21 @@ private:
 
 #if variant_CPP11_OR_GREATER
 
+#if variant_USES_UNION_STORAGE
+    variant_constexpr14 variant & move_assign( variant && other )
+    {
+        return move_assign( std::move( other ), trivially_copyable() );
+    }
+
+    variant_constexpr14 variant & move_assign( variant && other, std::true_type )
+    {
+        return copy_assign( other, std::true_type() );
+    }
+
+    variant & move_assign( variant && other, std::false_type )
+#else
     variant & move_assign( variant && other )
+#endif
     {
         if ( valueless_by_exception() && other.valueless_by_exception() )
         {
@@ -1873,23 +3686,57 @@ private:
         return *this;
     }
 
-    template< std::size_t K, class T >
-    variant & assign_value( T && value )
+    // Assign value to alternative K of type U [variant.assign]: assign it if K is the
+    // active alternative; otherwise construct U in place, or from a temporary if only
+    // that keeps the variant from becoming valueless. With union storage, a variant of
+    // trivially copyable alternatives copies a new union instead, also at compile time:
+
+    template< class U, class T >
+    struct replace_tag : std::integral_constant< int,
+#if variant_USES_UNION_STORAGE
+        trivially_copyable::value ? 0 :
+#endif
+        std::is_nothrow_constructible< U, T >::value || ! std::is_nothrow_move_constructible< U >::value ? 1 : 2 > {};
+
+    template< std::size_t K, class U, class T >
+    variant_constexpr14_union variant & assign_value( T && value )
     {
-        if( index() == K )
-        {
-            *as<T>() = std::forward<T>( value );
-        }
-        else
+        if ( index() == K )
         {
-            helper_type::destroy( type_index, ptr() );
-            type_index = variant_npos_internal();
-            new( ptr() ) T( std::forward<T>( value ) );
-            type_index = K;
+            alternative<U>() = std::forward<T>( value );
+            return *this;
         }
+
+        variant_PROFILE( construct, *this, K );
+        return replace_value< K, U >( std::forward<T>( value ), replace_tag< U, T >() );
+    }
+
+#if variant_USES_UNION_STORAGE
+    template< std::size_t K, class U, class T >
+    variant_constexpr14 variant & replace_value( T && value, std::integral_constant< int, 0 > )
+    {
+        static_cast< storage_type & >( *this ) = storage_type( detail::index_tag_t<K>(), std::forward<T>( value ) );
+        return *this;
+    }
+#endif
+
+    template< std::size_t K, class U, class T >
+    variant & replace_value( T && value, std::integral_constant< int, 1 > )
+    {
+        helper_type::destroy( type_index, ptr() );
+        type_index = variant_npos_internal();
+        type_index = helper_type::template construct_i<K>( ptr(), std::forward<T>( value ) );
         return *this;
     }
 
+    template< std::size_t K, class U, class T >
+    variant & replace_value( T && value, std::integral_constant< int, 2 > )
+    {
+        U temporary( std::forward<T>( value ) );
+
+        return replace_value< K, U >( std::move( temporary ), std::integral_constant< int, 1 >() );
+    }
+
 #endif // variant_CPP11_OR_GREATER
 
     template< std::size_t K, class T >
@@ -1897,7 +3744,7 @@ private:
     {
         if( index() == K )
         {
-            *as<T>() = value;
+            alternative<T>() = value;
         }
         else
         {
@@ -1909,31 +3756,27 @@ private:
         return *this;
     }
 
-    void swap_value( type_index_t index, variant & other )
+    struct swap_op : helper_type::void_op
     {
-        using std::swap;
-        switch( index )
-        {
-            case 0: swap( this->get<0>(), other.get<0>() ); break;
-            case 1: swap( this->get<1>(), other.get<1>() ); break;
-            case 2: swap( this->get<2>(), other.get<2>() ); break;
-            case 3: swap( this->get<3>(), other.get<3>() ); break;
-            case 4: swap( this->get<4>(), other.get<4>() ); break;
-            case 5: swap( this->get<5>(), other.get<5>() ); break;
-            case 6: swap( this->get<6>(), other.get<6>() ); break;
-            case 7: swap( this->get<7>(), other.get<7>() ); break;
-            case 8: swap( this->get<8>(), other.get<8>() ); break;
-            case 9: swap( this->get<9>(), other.get<9>() ); break;
-            case 10: swap( this->get<10>(), other.get<10>() ); break;
-            case 11: swap( this->get<11>(), other.get<11>() ); break;
-            case 12: swap( this->get<12>(), other.get<12>() ); break;
-            case 13: swap( this->get<13>(), other.get<13>() ); break;
-            case 14: swap( this->get<14>(), other.get<14>() ); break;
-            case 15: swap( this->get<15>(), other.get<15>() ); break;
-            
+        variant * self;
+        variant * other;
+
+        swap_op( variant * self_, variant * other_ ) : self( self_ ), other( other_ ) {}
+
+        template< std::size_t K >
+        void apply() const
+        {
+            using std::swap;
+            swap( self->template get<K>(), other->template get<K>() );
         }
+    };
+
+    void swap_value( type_index_t index, variant & other )
+    {
+        helper_type::alternative_switch::apply( helper_type::to_size_t( index ), swap_op( this, &other ) );
     }
 
+#if ! variant_USES_UNION_STORAGE
 private:
     enum { data_size  = detail::typelist_max_sizeof< variant_types >::value };
 
@@ -1964,6 +3807,7 @@ private:
 #endif // variant_CONFIG_MAX_ALIGN_HACK
 
     type_index_t type_index;
+#endif // variant_USES_UNION_STORAGE
 };
 
 // 19.7.5 Value access
@@ -1974,6 +3818,61 @@ inline variant_constexpr bool holds_alternative( variant<T0, T1, T2, T3, T4, T5,
     return v.index() == variant<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15>::template index_of<T>();
 }
 
+#if variant_CPP11_OR_GREATER
+
+// non-standard: test for one of several alternatives via a compile-time bitmask of their indices:
+
+namespace detail {
+
+typedef unsigned long long index_mask_t;
+
+template< class Variant, class... Ts >
+struct alternative_mask;
+
+template< class Variant >
+struct alternative_mask< Variant >
+{
+    static constexpr index_mask_t value = 0;
+};
+
+template< class Variant, class T, class... Ts >
+struct alternative_mask< Variant, T, Ts... >
+{
+    variant_STATIC_ASSERT( Variant::template index_of<T>() != variant_npos, "Type is not an alternative of the variant." );
+    variant_STATIC_ASSERT( Variant::template index_of<T>() < 64, "Alternative index exceeds the width of the index mask." );
+
+    static constexpr index_mask_t value = ( index_mask_t( 1 ) << Variant::template index_of<T>() ) | alternative_mask< Variant, Ts... >::value;
+};
+
+// single test without branches; the index of a valueless variant (variant_npos) never matches:
+
+inline constexpr bool index_in_mask( index_mask_t mask, std::size_t index ) variant_noexcept
+{
+    return 0 != ( ( mask >> ( index & 63u ) ) & static_cast<index_mask_t>( index < 64u ) );
+}
+
+} // namespace detail
+
+template< class... Ts, class T0, class T1, class T2, class T3, class T4, class T5, class T6, class T7, class T8, class T9, class T10, class T11, class T12, class T13, class T14, class T15 >
+inline constexpr bool holds_any_of( variant<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15> const & v ) variant_noexcept
+{
+    return detail::index_in_mask( detail::alternative_mask< variant<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15>, Ts... >::value, v.index() );
+}
+
+// predicate for use with standard algorithms, e.g. std::count_if( first, last, alternative_set<A, B>() ):
+
+template< class... Ts >
+struct alternative_set
+{
+    template< class Variant >
+    constexpr bool operator()( Variant const & v ) const variant_noexcept
+    {
+        return holds_any_of< Ts... >( v );
+    }
+};
+
+#endif // variant_CPP11_OR_GREATER
+
 template< class R, class T0, class T1, class T2, class T3, class T4, class T5, class T6, class T7, class T8, class T9, class T10, class T11, class T12, class T13, class T14, class T15 >
 inline variant_constexpr R & get( variant<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15> & v, nonstd_lite_in_place_type_t(R) = nonstd_lite_in_place_type(R) )
 {
@@ -1995,6 +3894,7 @@ get( variant<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T1
 #else
     if ( K != v.index() )
     {
+        variant_PROFILE( bad_access, v, K );
         throw bad_variant_access();
     }
 #endif
@@ -2010,6 +3910,7 @@ get( variant<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T1
 #else
     if ( K != v.index() )
     {
+        variant_PROFILE( bad_access, v, K );
         throw bad_variant_access();
     }
 #endif
@@ -2039,6 +3940,7 @@ get( variant<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T1
 #else
     if ( K != v.index() )
     {
+        variant_PROFILE( bad_access, v, K );
         throw bad_variant_access();
     }
 #endif
@@ -2054,6 +3956,7 @@ get( variant<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T1
 #else
     if ( K != v.index() )
     {
+        variant_PROFILE( bad_access, v, K );
         throw bad_variant_access();
     }
 #endif
@@ -2124,6 +4027,102 @@ inline void swap(
     a.swap( b );
 }
 
+// non-standard: algorithms over sequences of variants, inspecting the index only:
+
+namespace detail {
+
+struct index_equals
+{
+    std::size_t index;
+
+    explicit index_equals( std::size_t index_ )
+    : index( index_ ) {}
+
+    template< class Variant >
+    bool operator()( Variant const & v ) const
+    {
+        return v.index() == index;
+    }
+};
+
+} // namespace detail
+
+template< class T, class InputIt >
+inline std::size_t count_alternative( InputIt first, InputIt last )
+{
+    typedef typename std::iterator_traits< InputIt >::value_type variant_type;
+
+    variant_STATIC_ASSERT( variant_type::template index_of<T>() != variant_npos, "Type is not an alternative of the variant." );
+
+    std::size_t const index = variant_type::template index_of<T>();
+    std::size_t count = 0;
+
+    // branch-free: a plain add per element, which compilers can unroll and vectorize:
+
+    for ( ; first != last; ++first )
+    {
+        count += static_cast<std::size_t>( (*first).index() == index );
+    }
+    return count;
+}
+
+template< class T, class InputIt >
+inline InputIt find_alternative( InputIt first, InputIt last )
+{
+    typedef typename std::iterator_traits< InputIt >::value_type variant_type;
+
+    variant_STATIC_ASSERT( variant_type::template index_of<T>() != variant_npos, "Type is not an alternative of the variant." );
+
+    return std::find_if( first, last, detail::index_equals( variant_type::template index_of<T>() ) );
+}
+
+template< class BidirIt >
+inline BidirIt partition_by_index( BidirIt first, BidirIt last, std::size_t index )
+{
+    return std::partition( first, last, detail::index_equals( index ) );
+}
+
+// add the number of variants holding alternative i to counts[i], valueless variants are not counted:
+
+template< class InputIt, class RandomIt >
+inline void index_histogram( InputIt first, InputIt last, RandomIt counts )
+{
+    typedef typename std::iterator_traits< InputIt >::value_type variant_type;
+
+    std::size_t const size = variant_size< variant_type >::value;
+
+    for ( ; first != last; ++first )
+    {
+        std::size_t const index = (*first).index();
+
+        if ( index < size )
+        {
+            ++counts[ static_cast<std::ptrdiff_t>( index ) ];
+        }
+    }
+}
+
+#if variant_CPP11_OR_GREATER
+
+template< class T, class Range >
+inline std::size_t count_alternative( Range const & range )
+{
+    return count_alternative<T>( std::begin( range ), std::end( range ) );
+}
+
+template< class Range
+    , class Variant = typename std::decay< decltype( *std::begin( std::declval<Range const &>() ) ) >::type >
+inline std::array< std::size_t, variant_size<Variant>::value > index_histogram( Range const & range )
+{
+    std::array< std::size_t, variant_size<Variant>::value > counts = {};
+
+    index_histogram( std::begin( range ), std::end( range ), counts.begin() );
+
+    return counts;
+}
+
+#endif // variant_CPP11_OR_GREATER
+
 // 19.7.7 Visitation
 
 // Variant 'visitor' implementation
@@ -2135,7 +4134,7 @@ template< typename R, typename VT >
 struct VisitorApplicatorImpl
 {
     template< typename Visitor, typename T >
-    static R apply(Visitor const& v, T const& arg)
+    static variant_constexpr R apply(Visitor const& v, T const& arg)
     {
         return v(arg);
     }
@@ -2145,7 +4144,7 @@ template< typename R, typename VT >
 struct VisitorApplicatorImpl<R, TX<VT> >
 {
     template< typename Visitor, typename T >
-    static R apply(Visitor const&, T)
+    static variant_constexpr14 R apply(Visitor const&, T)
     {
         // prevent default construction of a const reference, see issue #39:
         std::terminate();
@@ -2171,7 +4170,7 @@ struct TypedVisitorUnwrapper<2, R, Visitor, T2>
     const Visitor& visitor;
     T2 const& val2;
     
-    TypedVisitorUnwrapper(const Visitor& visitor_, T2 const& val2_)
+    variant_constexpr TypedVisitorUnwrapper(const Visitor& visitor_, T2 const& val2_)
         : visitor(visitor_)
         , val2(val2_)
         
@@ -2179,7 +4178,7 @@ struct TypedVisitorUnwrapper<2, R, Visitor, T2>
     }
 
     template<typename T>
-    R operator()(const T& val1) const
+    variant_constexpr R operator()(const T& val1) const
     {
         return visitor(val1, val2);
     }
@@ -2192,7 +4191,7 @@ struct TypedVisitorUnwrapper<3, R, Visitor, T2, T3>
     T2 const& val2;
     T3 const& val3;
     
-    TypedVisitorUnwrapper(const Visitor& visitor_, T2 const& val2_, T3 const& val3_)
+    variant_constexpr TypedVisitorUnwrapper(const Visitor& visitor_, T2 const& val2_, T3 const& val3_)
         : visitor(visitor_)
         , val2(val2_)
         , val3(val3_)
@@ -2201,7 +4200,7 @@ struct TypedVisitorUnwrapper<3, R, Visitor, T2, T3>
     }
 
     template<typename T>
-    R operator()(const T& val1) const
+    variant_constexpr R operator()(const T& val1) const
     {
         return visitor(val1, val2, val3);
     }
@@ -2215,7 +4214,7 @@ struct TypedVisitorUnwrapper<4, R, Visitor, T2, T3, T4>
     T3 const& val3;
     T4 const& val4;
     
-    TypedVisitorUnwrapper(const Visitor& visitor_, T2 const& val2_, T3 const& val3_, T4 const& val4_)
+    variant_constexpr TypedVisitorUnwrapper(const Visitor& visitor_, T2 const& val2_, T3 const& val3_, T4 const& val4_)
         : visitor(visitor_)
         , val2(val2_)
         , val3(val3_)
@@ -2225,7 +4224,7 @@ struct TypedVisitorUnwrapper<4, R, Visitor, T2, T3, T4>
     }
 
     template<typename T>
-    R operator()(const T& val1) const
+    variant_constexpr R operator()(const T& val1) const
     {
         return visitor(val1, val2, val3, val4);
     }
@@ -2240,7 +4239,7 @@ struct TypedVisitorUnwrapper<5, R, Visitor, T2, T3, T4, T5>
     T4 const& val4;
     T5 const& val5;
     
-    TypedVisitorUnwrapper(const Visitor& visitor_, T2 const& val2_, T3 const& val3_, T4 const& val4_, T5 const& val5_)
+    variant_constexpr TypedVisitorUnwrapper(const Visitor& visitor_, T2 const& val2_, T3 const& val3_, T4 const& val4_, T5 const& val5_)
         : visitor(visitor_)
         , val2(val2_)
         , val3(val3_)
@@ -2251,7 +4250,7 @@ struct TypedVisitorUnwrapper<5, R, Visitor, T2, T3, T4, T5>
     }
 
     template<typename T>
-    R operator()(const T& val1) const
+    variant_constexpr R operator()(const T& val1) const
     {
         return visitor(val1, val2, val3, val4, val5);
     }
@@ -2265,7 +4264,7 @@ struct VisitorUnwrapper
     const Visitor& visitor;
     const V2& r;
 
-    VisitorUnwrapper(const Visitor& visitor_, const V2& r_)
+    variant_constexpr VisitorUnwrapper(const Visitor& visitor_, const V2& r_)
         : visitor(visitor_)
         , r(r_)
     {
@@ -2273,35 +4272,35 @@ struct VisitorUnwrapper
 
     
     template< typename T1 >
-    R operator()(T1 const& val1) const
+    variant_constexpr14 R operator()(T1 const& val1) const
     {
         typedef TypedVisitorUnwrapper<2, R, Visitor, T1> visitor_type;
         return VisitorApplicator<R>::apply(visitor_type(visitor, val1), r);
     }
     
     template< typename T1, typename T2 >
-    R operator()(T1 const& val1, T2 const& val2) const
+    variant_constexpr14 R operator()(T1 const& val1, T2 const& val2) const
     {
         typedef TypedVisitorUnwrapper<3, R, Visitor, T1, T2> visitor_type;
         return VisitorApplicator<R>::apply(visitor_type(visitor, val1, val2), r);
     }
     
     template< typename T1, typename T2, typename T3 >
-    R operator()(T1 const& val1, T2 const& val2, T3 const& val3) const
+    variant_constexpr14 R operator()(T1 const& val1, T2 const& val2, T3 const& val3) const
     {
         typedef TypedVisitorUnwrapper<4, R, Visitor, T1, T2, T3> visitor_type;
         return VisitorApplicator<R>::apply(visitor_type(visitor, val1, val2, val3), r);
     }
     
     template< typename T1, typename T2, typename T3, typename T4 >
-    R operator()(T1 const& val1, T2 const& val2, T3 const& val3, T4 const& val4) const
+    variant_constexpr14 R operator()(T1 const& val1, T2 const& val2, T3 const& val3, T4 const& val4) const
     {
         typedef TypedVisitorUnwrapper<5, R, Visitor, T1, T2, T3, T4> visitor_type;
         return VisitorApplicator<R>::apply(visitor_type(visitor, val1, val2, val3, val4), r);
     }
     
     template< typename T1, typename T2, typename T3, typename T4, typename T5 >
-    R operator()(T1 const& val1, T2 const& val2, T3 const& val3, T4 const& val4, T5 const& val5) const
+    variant_constexpr14 R operator()(T1 const& val1, T2 const& val2, T3 const& val3, T4 const& val4, T5 const& val5) const
     {
         typedef TypedVisitorUnwrapper<6, R, Visitor, T1, T2, T3, T4, T5> visitor_type;
         return VisitorApplicator<R>::apply(visitor_type(visitor, val1, val2, val3, val4, val5), r);
@@ -2314,34 +4313,37 @@ template<typename R>
 struct VisitorApplicator
 {
     template<typename Visitor, typename V1>
-    static R apply(const Visitor& v, const V1& arg)
-    {
-        switch( arg.index() )
-        {
-            case 0: return apply_visitor<0>(v, arg);
-            case 1: return apply_visitor<1>(v, arg);
-            case 2: return apply_visitor<2>(v, arg);
-            case 3: return apply_visitor<3>(v, arg);
-            case 4: return apply_visitor<4>(v, arg);
-            case 5: return apply_visitor<5>(v, arg);
-            case 6: return apply_visitor<6>(v, arg);
-            case 7: return apply_visitor<7>(v, arg);
-            case 8: return apply_visitor<8>(v, arg);
-            case 9: return apply_visitor<9>(v, arg);
-            case 10: return apply_visitor<10>(v, arg);
-            case 11: return apply_visitor<11>(v, arg);
-            case 12: return apply_visitor<12>(v, arg);
-            case 13: return apply_visitor<13>(v, arg);
-            case 14: return apply_visitor<14>(v, arg);
-            case 15: return apply_visitor<15>(v, arg);
-            
-            // prevent default construction of a const reference, see issue #39:
-            default: std::terminate();
+    struct visit_op
+    {
+        typedef R result_type;
+
+        const Visitor& v;
+        const V1& arg;
+
+        variant_constexpr visit_op(const Visitor& v_, const V1& arg_) : v(v_), arg(arg_) {}
+
+        template<size_t Idx>
+        variant_constexpr R apply() const
+        {
+            return apply_visitor<Idx>(v, arg);
+        }
+
+        // prevent default construction of a const reference, see issue #39:
+        variant_constexpr14 R otherwise() const
+        {
+            std::terminate();
         }
+    };
+
+    template<typename Visitor, typename V1>
+    static variant_constexpr14 R apply(const Visitor& v, const V1& arg)
+    {
+        variant_PROFILE( visit, arg, arg.index() );
+        return index_switch_likely< static_cast<std::size_t>( variant_CONFIG_LIKELY_INDEX ), variant_size<V1>::value >::apply(arg.index(), visit_op<Visitor, V1>(v, arg));
     }
 
     template<size_t Idx, typename Visitor, typename V1>
-    static R apply_visitor(const Visitor& v, const V1& arg)
+    static variant_constexpr14 R apply_visitor(const Visitor& v, const V1& arg)
     {
 
 #if variant_CPP11_OR_GREATER
@@ -2354,7 +4356,7 @@ struct VisitorApplicator
 
 #if variant_CPP11_OR_GREATER
     template<typename Visitor, typename V1, typename V2, typename ... V>
-    static R apply(const Visitor& v, const V1& arg1, const V2& arg2, const V ... args)
+    static variant_constexpr14 R apply(const Visitor& v, const V1& arg1, const V2& arg2, const V& ... args)
     {
         typedef VisitorUnwrapper<R, Visitor, V1> Unwrapper;
         Unwrapper unwrapper(v, arg1);
@@ -2363,7 +4365,7 @@ struct VisitorApplicator
 #else
     
     template< typename Visitor, typename V1, typename V2 >
-    static R apply(const Visitor& v, V1 const& arg1, V2 const& arg2)
+    static variant_constexpr14 R apply(const Visitor& v, V1 const& arg1, V2 const& arg2)
     {
         typedef VisitorUnwrapper<R, Visitor, V1> Unwrapper;
         Unwrapper unwrapper(v, arg1);
@@ -2371,7 +4373,7 @@ struct VisitorApplicator
     }
     
     template< typename Visitor, typename V1, typename V2, typename V3 >
-    static R apply(const Visitor& v, V1 const& arg1, V2 const& arg2, V3 const& arg3)
+    static variant_constexpr14 R apply(const Visitor& v, V1 const& arg1, V2 const& arg2, V3 const& arg3)
     {
         typedef VisitorUnwrapper<R, Visitor, V1> Unwrapper;
         Unwrapper unwrapper(v, arg1);
@@ -2379,7 +4381,7 @@ struct VisitorApplicator
     }
     
     template< typename Visitor, typename V1, typename V2, typename V3, typename V4 >
-    static R apply(const Visitor& v, V1 const& arg1, V2 const& arg2, V3 const& arg3, V4 const& arg4)
+    static variant_constexpr14 R apply(const Visitor& v, V1 const& arg1, V2 const& arg2, V3 const& arg3, V4 const& arg4)
     {
         typedef VisitorUnwrapper<R, Visitor, V1> Unwrapper;
         Unwrapper unwrapper(v, arg1);
@@ -2387,7 +4389,7 @@ struct VisitorApplicator
     }
     
     template< typename Visitor, typename V1, typename V2, typename V3, typename V4, typename V5 >
-    static R apply(const Visitor& v, V1 const& arg1, V2 const& arg2, V3 const& arg3, V4 const& arg4, V5 const& arg5)
+    static variant_constexpr14 R apply(const Visitor& v, V1 const& arg1, V2 const& arg2, V3 const& arg3, V4 const& arg4, V5 const& arg5)
     {
         typedef VisitorUnwrapper<R, Visitor, V1> Unwrapper;
         Unwrapper unwrapper(v, arg1);
@@ -2410,7 +4412,7 @@ struct VisitorImpl
 #if variant_CPP11_OR_GREATER
 // No perfect forwarding here in order to simplify code
 template< typename Visitor, typename ... V >
-inline variant_constexpr auto visit(Visitor const& v, V const& ... vars) -> typename detail::VisitorImpl<sizeof ... (V), Visitor, V... > ::result_type
+inline variant_constexpr14 auto visit(Visitor const& v, V const& ... vars) -> typename detail::VisitorImpl<sizeof ... (V), Visitor, V... > ::result_type
 {
     typedef detail::VisitorImpl<sizeof ... (V), Visitor, V... > impl_type;
     return impl_type::applicator_type::apply(v, vars...);
@@ -2418,31 +4420,31 @@ inline variant_constexpr auto visit(Visitor const& v, V const& ... vars) -> type
 #else
 
 template< typename R, typename Visitor, typename V1 >
-inline variant_constexpr R visit(const Visitor& v, V1 const& arg1)
+inline variant_constexpr14 R visit(const Visitor& v, V1 const& arg1)
 {
     return detail::VisitorApplicator<R>::apply(v, arg1);
 }
 
 template< typename R, typename Visitor, typename V1, typename V2 >
-inline variant_constexpr R visit(const Visitor& v, V1 const& arg1, V2 const& arg2)
+inline variant_constexpr14 R visit(const Visitor& v, V1 const& arg1, V2 const& arg2)
 {
     return detail::VisitorApplicator<R>::apply(v, arg1, arg2);
 }
 
 template< typename R, typename Visitor, typename V1, typename V2, typename V3 >
-inline variant_constexpr R visit(const Visitor& v, V1 const& arg1, V2 const& arg2, V3 const& arg3)
+inline variant_constexpr14 R visit(const Visitor& v, V1 const& arg1, V2 const& arg2, V3 const& arg3)
 {
     return detail::VisitorApplicator<R>::apply(v, arg1, arg2, arg3);
 }
 
 template< typename R, typename Visitor, typename V1, typename V2, typename V3, typename V4 >
-inline variant_constexpr R visit(const Visitor& v, V1 const& arg1, V2 const& arg2, V3 const& arg3, V4 const& arg4)
+inline variant_constexpr14 R visit(const Visitor& v, V1 const& arg1, V2 const& arg2, V3 const& arg3, V4 const& arg4)
 {
     return detail::VisitorApplicator<R>::apply(v, arg1, arg2, arg3, arg4);
 }
 
 template< typename R, typename Visitor, typename V1, typename V2, typename V3, typename V4, typename V5 >
-inline variant_constexpr R visit(const Visitor& v, V1 const& arg1, V2 const& arg2, V3 const& arg3, V4 const& arg4, V5 const& arg5)
+inline variant_constexpr14 R visit(const Visitor& v, V1 const& arg1, V2 const& arg2, V3 const& arg3, V4 const& arg4, V5 const& arg5)
 {
     return detail::VisitorApplicator<R>::apply(v, arg1, arg2, arg3, arg4, arg5);
 }
@@ -2456,54 +4458,44 @@ namespace detail {
 template< class Variant >
 struct Comparator
 {
-    static inline bool equal( Variant const & v, Variant const & w )
-    {
-        switch( v.index() )
-        {
-            case 0: return get<0>( v ) == get<0>( w );
-            case 1: return get<1>( v ) == get<1>( w );
-            case 2: return get<2>( v ) == get<2>( w );
-            case 3: return get<3>( v ) == get<3>( w );
-            case 4: return get<4>( v ) == get<4>( w );
-            case 5: return get<5>( v ) == get<5>( w );
-            case 6: return get<6>( v ) == get<6>( w );
-            case 7: return get<7>( v ) == get<7>( w );
-            case 8: return get<8>( v ) == get<8>( w );
-            case 9: return get<9>( v ) == get<9>( w );
-            case 10: return get<10>( v ) == get<10>( w );
-            case 11: return get<11>( v ) == get<11>( w );
-            case 12: return get<12>( v ) == get<12>( w );
-            case 13: return get<13>( v ) == get<13>( w );
-            case 14: return get<14>( v ) == get<14>( w );
-            case 15: return get<15>( v ) == get<15>( w );
-            
-            default: return false;
-        }
-    }
-
-    static inline bool less_than( Variant const & v, Variant const & w )
-    {
-        switch( v.index() )
-        {
-            case 0: return get<0>( v ) < get<0>( w );
-            case 1: return get<1>( v ) < get<1>( w );
-            case 2: return get<2>( v ) < get<2>( w );
-            case 3: return get<3>( v ) < get<3>( w );
-            case 4: return get<4>( v ) < get<4>( w );
-            case 5: return get<5>( v ) < get<5>( w );
-            case 6: return get<6>( v ) < get<6>( w );
-            case 7: return get<7>( v ) < get<7>( w );
-            case 8: return get<8>( v ) < get<8>( w );
-            case 9: return get<9>( v ) < get<9>( w );
-            case 10: return get<10>( v ) < get<10>( w );
-            case 11: return get<11>( v ) < get<11>( w );
-            case 12: return get<12>( v ) < get<12>( w );
-            case 13: return get<13>( v ) < get<13>( w );
-            case 14: return get<14>( v ) < get<14>( w );
-            case 15: return get<15>( v ) < get<15>( w );
-            
-            default: return false;
-        }
+    typedef index_switch< 0, variant_size< Variant >::value > alternative_switch;
+
+    struct compare_op
+    {
+        typedef bool result_type;
+
+        Variant const & v;
+        Variant const & w;
+
+        variant_constexpr compare_op( Variant const & v_, Variant const & w_ ) : v( v_ ), w( w_ ) {}
+
+        variant_constexpr bool otherwise() const { return false; }
+    };
+
+    struct equal_op : compare_op
+    {
+        variant_constexpr equal_op( Variant const & v_, Variant const & w_ ) : compare_op( v_, w_ ) {}
+
+        template< std::size_t K >
+        variant_constexpr14 bool apply() const { return get<K>( this->v ) == get<K>( this->w ); }
+    };
+
+    struct less_than_op : compare_op
+    {
+        variant_constexpr less_than_op( Variant const & v_, Variant const & w_ ) : compare_op( v_, w_ ) {}
+
+        template< std::size_t K >
+        variant_constexpr14 bool apply() const { return get<K>( this->v ) < get<K>( this->w ); }
+    };
+
+    static inline variant_constexpr14 bool equal( Variant const & v, Variant const & w )
+    {
+        return alternative_switch::apply( v.index(), equal_op( v, w ) );
+    }
+
+    static inline variant_constexpr14 bool less_than( Variant const & v, Variant const & w )
+    {
+        return alternative_switch::apply( v.index(), less_than_op( v, w ) );
     }
 };
 
@@ -2595,32 +4587,125 @@ struct hash< nonstd::variant<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T
     {
         namespace nvd = nonstd::variants::detail;
 
-        switch( v.index() )
-        {
-            case 0: return nvd::hash( 0 ) ^ nvd::hash( get<0>( v ) );
-            case 1: return nvd::hash( 1 ) ^ nvd::hash( get<1>( v ) );
-            case 2: return nvd::hash( 2 ) ^ nvd::hash( get<2>( v ) );
-            case 3: return nvd::hash( 3 ) ^ nvd::hash( get<3>( v ) );
-            case 4: return nvd::hash( 4 ) ^ nvd::hash( get<4>( v ) );
-            case 5: return nvd::hash( 5 ) ^ nvd::hash( get<5>( v ) );
-            case 6: return nvd::hash( 6 ) ^ nvd::hash( get<6>( v ) );
-            case 7: return nvd::hash( 7 ) ^ nvd::hash( get<7>( v ) );
-            case 8: return nvd::hash( 8 ) ^ nvd::hash( get<8>( v ) );
-            case 9: return nvd::hash( 9 ) ^ nvd::hash( get<9>( v ) );
-            case 10: return nvd::hash( 10 ) ^ nvd::hash( get<10>( v ) );
-            case 11: return nvd::hash( 11 ) ^ nvd::hash( get<11>( v ) );
-            case 12: return nvd::hash( 12 ) ^ nvd::hash( get<12>( v ) );
-            case 13: return nvd::hash( 13 ) ^ nvd::hash( get<13>( v ) );
-            case 14: return nvd::hash( 14 ) ^ nvd::hash( get<14>( v ) );
-            case 15: return nvd::hash( 15 ) ^ nvd::hash( get<15>( v ) );
-            
-            default: return 0;
-        }
+        return nvd::index_switch< 0, nonstd::variant_size< nonstd::variant<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15> >::value >::apply( v.index(), hash_op( v ) );
     }
+
+private:
+    struct hash_op
+    {
+        typedef std::size_t result_type;
+
+        nonstd::variant<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15> const & v;
+
+        explicit hash_op( nonstd::variant<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15> const & v_ ) : v( v_ ) {}
+
+        template< std::size_t K >
+        std::size_t apply() const
+        {
+            namespace nvd = nonstd::variants::detail;
+
+            return nvd::hash( static_cast<int>( K ) ) ^ nvd::hash( get<K>( v ) );
+        }
+
+        std::size_t otherwise() const { return 0; }
+    };
 };
 
 } //namespace std
 
+// Explicit instantiation of the index-dispatched operations of a variant type V, which
+// may be a typedef: variant_INSTANTIATE( V ) in one translation unit defines them and
+// variant_EXTERN_INSTANTIATE( V ) elsewhere declares them, so that they are neither
+// instantiated nor emitted there. Use at global namespace scope, without semicolon.
+
+namespace nonstd { namespace variants { namespace detail {
+
+template< class V >
+struct variant_parameters;
+
+template< class T0, class T1, class T2, class T3, class T4, class T5, class T6, class T7, class T8, class T9, class T10, class T11, class T12, class T13, class T14, class T15 >
+struct variant_parameters< variant<T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15> >
+{
+    typedef T0 type0;
+    typedef T1 type1;
+    typedef T2 type2;
+    typedef T3 type3;
+    typedef T4 type4;
+    typedef T5 type5;
+    typedef T6 type6;
+    typedef T7 type7;
+    typedef T8 type8;
+    typedef T9 type9;
+    typedef T10 type10;
+    typedef T11 type11;
+    typedef T12 type12;
+    typedef T13 type13;
+    typedef T14 type14;
+    typedef T15 type15;
+    };
+
+}}} // namespace nonstd::variants::detail
+
+// destruction, copy and move; alternatives must be copy and move constructible and assignable:
+
+#define variant_INSTANTIATE_HELPER_( extern_, V ) \
+    extern_ template struct nonstd::variants::detail::helper< \
+        nonstd::variants::detail::variant_parameters< V >::type0, \
+        nonstd::variants::detail::variant_parameters< V >::type1, \
+        nonstd::variants::detail::variant_parameters< V >::type2, \
+        nonstd::variants::detail::variant_parameters< V >::type3, \
+        nonstd::variants::detail::variant_parameters< V >::type4, \
+        nonstd::variants::detail::variant_parameters< V >::type5, \
+        nonstd::variants::detail::variant_parameters< V >::type6, \
+        nonstd::variants::detail::variant_parameters< V >::type7, \
+        nonstd::variants::detail::variant_parameters< V >::type8, \
+        nonstd::variants::detail::variant_parameters< V >::type9, \
+        nonstd::variants::detail::variant_parameters< V >::type10, \
+        nonstd::variants::detail::variant_parameters< V >::type11, \
+        nonstd::variants::detail::variant_parameters< V >::type12, \
+        nonstd::variants::detail::variant_parameters< V >::type13, \
+        nonstd::variants::detail::variant_parameters< V >::type14, \
+        nonstd::variants::detail::variant_parameters< V >::type15 >;
+
+#define variant_INSTANTIATE( V )         variant_INSTANTIATE_HELPER_( , V )
+#define variant_EXTERN_INSTANTIATE( V )  variant_INSTANTIATE_HELPER_( extern, V )
+
+// relational operators; alternatives must provide operator== and operator<:
+
+#define variant_INSTANTIATE_COMPARISON_( extern_, V ) \
+    extern_ template bool nonstd::variants::detail::Comparator< V >::equal( V const &, V const & ); \
+    extern_ template bool nonstd::variants::detail::Comparator< V >::less_than( V const &, V const & );
+
+#define variant_INSTANTIATE_COMPARISON( V )         variant_INSTANTIATE_COMPARISON_( , V )
+#define variant_EXTERN_INSTANTIATE_COMPARISON( V )  variant_INSTANTIATE_COMPARISON_( extern, V )
+
+// std::hash<V>; alternatives must be hashable:
+
+#define variant_INSTANTIATE_HASH( V )         template struct std::hash< V >;
+#define variant_EXTERN_INSTANTIATE_HASH( V )  extern template struct std::hash< V >;
+
+// visit( Visitor(), V ) for a visitor class that is used in many translation units:
+
+#define variant_INSTANTIATE_VISIT_( extern_, Visitor, V ) \
+    extern_ template nonstd::variants::detail::VisitorImpl< 1, Visitor, V >::result_type \
+        nonstd::variants::detail::VisitorImpl< 1, Visitor, V >::applicator_type::apply< Visitor, V >( Visitor const &, V const & );
+
+#define variant_INSTANTIATE_VISIT( Visitor, V )         variant_INSTANTIATE_VISIT_( , Visitor, V )
+#define variant_EXTERN_INSTANTIATE_VISIT( Visitor, V )  variant_INSTANTIATE_VISIT_( extern, Visitor, V )
+
+#else // variant_CPP11_OR_GREATER
+
+// explicit instantiation declarations require C++11; the operations are instantiated implicitly:
+
+#define variant_INSTANTIATE( V )
+#define variant_EXTERN_INSTANTIATE( V )
+#define variant_INSTANTIATE_COMPARISON( V )
+#define variant_EXTERN_INSTANTIATE_COMPARISON( V )
+#define variant_INSTANTIATE_HASH( V )
+#define variant_EXTERN_INSTANTIATE_HASH( V )
+#define variant_INSTANTIATE_VISIT( Visitor, V )
+#define variant_EXTERN_INSTANTIATE_VISIT( Visitor, V )
+
 #endif // variant_CPP11_OR_GREATER
 
 #if variant_BETWEEN( variant_COMPILER_MSVC_VER, 1300, 1900 )
@@ -0,0 +1,511 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Atomic variant for small variants with trivially copyable alternatives
+// (C++11 and later).
+//
+// atomic_variant<V> keeps the index and the value of the variant packed into
+// a single word: one byte index followed by the object representation of the
+// value, with unused bytes zero. Up to 8 bytes, the word is a std::atomic<
+// std::uint64_t>; up to 16 bytes, it uses a double-width compare-and-swap
+// where available (GCC/Clang with -mcx16 on x86-64, for example); otherwise
+// it is protected by a spin lock, as reported by is_lock_free().
+//
+// As compare_exchange_*() compares object representations, alternatives must
+// not have padding bytes, see atomic_variant_bitwise_comparable<T>.
+
+#pragma once
+
+#ifndef NONSTD_VARIANT_ATOMIC_HPP
+#define NONSTD_VARIANT_ATOMIC_HPP
+
+#include "variant_util.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+
+#if defined( __GCC_HAVE_SYNC_COMPARE_AND_SWAP_16 )
+# define variant_HAVE_DWCAS  1
+#else
+# define variant_HAVE_DWCAS  0
+#endif
+
+#if defined( __cpp_lib_has_unique_object_representations )
+# define variant_HAS_UNIQUE_OBJECT_REPRESENTATIONS( T )  std::has_unique_object_representations< T >::value
+#elif defined( __has_builtin )
+# if __has_builtin( __has_unique_object_representations )
+#  define variant_HAS_UNIQUE_OBJECT_REPRESENTATIONS( T )  __has_unique_object_representations( T )
+# endif
+#elif defined( _MSC_VER ) && _MSC_VER >= 1911
+# define variant_HAS_UNIQUE_OBJECT_REPRESENTATIONS( T )  __has_unique_object_representations( T )
+#endif
+
+#ifndef variant_HAS_UNIQUE_OBJECT_REPRESENTATIONS
+# define variant_HAS_UNIQUE_OBJECT_REPRESENTATIONS( T )  ( std::is_scalar< T >::value && ! std::is_same< T, long double >::value )
+#endif
+
+namespace nonstd {
+
+// non-standard: whether values of T can be compared by their object
+// representation: T has no padding bytes, is empty, or is float or double
+// (compared bitwise, as std::atomic does). Where the compiler cannot tell,
+// only scalar types qualify; specialize it as std::true_type for a trivially
+// copyable type without padding bytes:
+
+template< class T >
+struct atomic_variant_bitwise_comparable : std::integral_constant< bool,
+    variant_HAS_UNIQUE_OBJECT_REPRESENTATIONS( T )
+    || std::is_empty< T >::value
+    || std::is_same< T, float >::value
+    || std::is_same< T, double >::value > {};
+
+namespace variants {
+namespace detail {
+
+// word of up to 8 bytes:
+
+struct atomic_word_storage
+{
+    typedef std::uint64_t word_type;
+
+    static constexpr bool is_always_lock_free = ATOMIC_LLONG_LOCK_FREE == 2;
+
+    explicit atomic_word_storage( word_type w ) noexcept
+        : value( w ) {}
+
+    bool is_lock_free() const noexcept
+    {
+        return value.is_lock_free();
+    }
+
+    word_type load( std::memory_order order ) const noexcept
+    {
+        return value.load( order );
+    }
+
+    void store( word_type w, std::memory_order order ) noexcept
+    {
+        value.store( w, order );
+    }
+
+    word_type exchange( word_type w, std::memory_order order ) noexcept
+    {
+        return value.exchange( w, order );
+    }
+
+    bool compare_exchange_weak( word_type & expected, word_type desired, std::memory_order success, std::memory_order failure ) noexcept
+    {
+        return value.compare_exchange_weak( expected, desired, success, failure );
+    }
+
+    bool compare_exchange_strong( word_type & expected, word_type desired, std::memory_order success, std::memory_order failure ) noexcept
+    {
+        return value.compare_exchange_strong( expected, desired, success, failure );
+    }
+
+    std::atomic< word_type > value;
+};
+
+#if variant_HAVE_DWCAS
+
+// word of up to 16 bytes, via double-width compare-and-swap; the __sync
+// builtins are full barriers, hence the memory order is not used:
+
+struct atomic_dwcas_storage
+{
+    __extension__ typedef unsigned __int128 word_type;
+
+    static constexpr bool is_always_lock_free = true;
+
+    explicit atomic_dwcas_storage( word_type w ) noexcept
+        : value( w ) {}
+
+    bool is_lock_free() const noexcept
+    {
+        return true;
+    }
+
+    word_type load( std::memory_order ) const noexcept
+    {
+        return __sync_val_compare_and_swap( &value, word_type( 0 ), word_type( 0 ) );
+    }
+
+    void store( word_type w, std::memory_order order ) noexcept
+    {
+        exchange( w, order );
+    }
+
+    word_type exchange( word_type w, std::memory_order order ) noexcept
+    {
+        word_type expected = load( order );
+
+        while ( ! compare_exchange_strong( expected, w, order, order ) ) {}
+
+        return expected;
+    }
+
+    bool compare_exchange_weak( word_type & expected, word_type desired, std::memory_order success, std::memory_order failure ) noexcept
+    {
+        return compare_exchange_strong( expected, desired, success, failure );
+    }
+
+    bool compare_exchange_strong( word_type & expected, word_type desired, std::memory_order, std::memory_order ) noexcept
+    {
+        word_type const previous = __sync_val_compare_and_swap( &value, expected, desired );
+
+        if ( previous == expected )
+        {
+            return true;
+        }
+        expected = previous;
+        return false;
+    }
+
+    alignas( 16 ) mutable word_type value;
+};
+
+#endif // variant_HAVE_DWCAS
+
+// word of N bytes, protected by a spin lock:
+
+template< std::size_t N >
+struct atomic_locked_storage
+{
+    struct word_type
+    {
+        unsigned char bytes[ N ];
+    };
+
+    static constexpr bool is_always_lock_free = false;
+
+    explicit atomic_locked_storage( word_type w ) noexcept
+        : value( w ) {}
+
+    bool is_lock_free() const noexcept
+    {
+        return false;
+    }
+
+    word_type load( std::memory_order ) const noexcept
+    {
+        guard lock( flag );
+        return value;
+    }
+
+    void store( word_type w, std::memory_order ) noexcept
+    {
+        guard lock( flag );
+        value = w;
+    }
+
+    word_type exchange( word_type w, std::memory_order ) noexcept
+    {
+        guard lock( flag );
+        word_type const previous = value;
+        value = w;
+        return previous;
+    }
+
+    bool compare_exchange_weak( word_type & expected, word_type desired, std::memory_order success, std::memory_order failure ) noexcept
+    {
+        return compare_exchange_strong( expected, desired, success, failure );
+    }
+
+    bool compare_exchange_strong( word_type & expected, word_type desired, std::memory_order, std::memory_order ) noexcept
+    {
+        guard lock( flag );
+
+        if ( std::memcmp( &value, &expected, N ) == 0 )
+        {
+            value = desired;
+            return true;
+        }
+        expected = value;
+        return false;
+    }
+
+    struct guard
+    {
+        std::atomic_flag & flag;
+
+        explicit guard( std::atomic_flag & flag_ ) noexcept
+            : flag( flag_ )
+        {
+            while ( flag.test_and_set( std::memory_order_acquire ) ) {}
+        }
+
+        ~guard()
+        {
+            flag.clear( std::memory_order_release );
+        }
+    };
+
+    mutable std::atomic_flag flag = ATOMIC_FLAG_INIT;
+    word_type value;
+};
+
+template< std::size_t N >
+struct atomic_storage_for
+    : std::conditional< ( N <= sizeof( std::uint64_t ) )
+        , atomic_word_storage
+#if variant_HAVE_DWCAS
+        , typename std::conditional< ( N <= 16 ), atomic_dwcas_storage, atomic_locked_storage< N > >::type
+#else
+        , atomic_locked_storage< N >
+#endif
+    > {};
+
+// the packed word of a variant: one byte index, followed by the value:
+
+template< class V, class W >
+struct packed_variant
+{
+    struct pack_value
+    {
+        V const & v;
+        unsigned char * bytes;
+
+        // the byte of an empty type is not part of its value:
+
+        template< std::size_t K >
+        void operator()( std::integral_constant< std::size_t, K > ) const
+        {
+            typedef typename variant_alternative< K, V >::type type;
+
+            std::memcpy( bytes + 1, nonstd::get_if<K>( &v ), std::is_empty< type >::value ? 0 : sizeof( type ) );
+        }
+    };
+
+    struct unpack_value
+    {
+        unsigned char const * bytes;
+
+        template< std::size_t K >
+        V operator()( std::integral_constant< std::size_t, K > ) const
+        {
+            typedef typename variant_alternative< K, V >::type type;
+
+            alignas( type ) unsigned char value[ sizeof( type ) ];
+
+            std::memcpy( value, bytes + 1, sizeof( type ) );
+
+            return V( nonstd_lite_in_place_index(K), *reinterpret_cast<type const *>( value ) );
+        }
+    };
+
+    template< class F >
+    struct visit_value
+    {
+        unsigned char const * bytes;
+        F & f;
+
+        template< std::size_t K >
+        auto operator()( std::integral_constant< std::size_t, K > ) const
+            -> decltype( f( std::declval< typename variant_alternative< 0, V >::type const & >() ) )
+        {
+            typedef typename variant_alternative< K, V >::type type;
+
+            alignas( type ) unsigned char value[ sizeof( type ) ];
+
+            std::memcpy( value, bytes + 1, sizeof( type ) );
+
+            return f( *reinterpret_cast<type const *>( value ) );
+        }
+    };
+
+    static W pack( V const & v ) noexcept
+    {
+        unsigned char bytes[ sizeof( W ) ] = {};
+        pack_value const pack = { v, bytes };
+
+        bytes[0] = static_cast<unsigned char>( v.index() );
+        with_index< variant_size<V>::value >( v.index(), pack );
+
+        W w;
+        std::memcpy( &w, bytes, sizeof( W ) );
+        return w;
+    }
+
+    static V unpack( W w ) noexcept
+    {
+        unsigned char bytes[ sizeof( W ) ];
+        std::memcpy( bytes, &w, sizeof( W ) );
+
+        unpack_value const unpack = { bytes };
+
+        return with_index< variant_size<V>::value >( bytes[0], unpack );
+    }
+
+    static std::size_t index( W w ) noexcept
+    {
+        unsigned char bytes[ sizeof( W ) ];
+        std::memcpy( bytes, &w, sizeof( W ) );
+
+        return bytes[0];
+    }
+
+    template< class F >
+    static auto visit( W w, F & f )
+        -> decltype( f( std::declval< typename variant_alternative< 0, V >::type const & >() ) )
+    {
+        unsigned char bytes[ sizeof( W ) ];
+        std::memcpy( bytes, &w, sizeof( W ) );
+
+        visit_value< F > const visit = { bytes, f };
+
+        return with_index< variant_size<V>::value >( bytes[0], visit );
+    }
+};
+
+template< class V, std::size_t K = variant_size<V>::value >
+struct alternatives_are_bitwise_comparable
+    : std::integral_constant< bool,
+        atomic_variant_bitwise_comparable< typename variant_alternative< K - 1, V >::type >::value
+        && alternatives_are_bitwise_comparable< V, K - 1 >::value > {};
+
+template< class V >
+struct alternatives_are_bitwise_comparable< V, 0 > : std::true_type {};
+
+} // namespace detail
+} // namespace variants
+
+// non-standard: atomic variant, see above; the variant must not be valueless.
+// compare_exchange_*() compares the object representation of the values.
+
+template< class V >
+class atomic_variant
+{
+    static_assert( variant_is_trivially_copyable< V >::value, "atomic_variant requires trivially copyable alternatives." );
+    static_assert( variant_size< V >::value <= 255, "atomic_variant supports at most 255 alternatives." );
+    static_assert( variants::detail::alternatives_are_bitwise_comparable< V >::value
+        , "atomic_variant requires alternatives without padding bytes, see atomic_variant_bitwise_comparable." );
+
+    typedef typename variants::detail::atomic_storage_for< 1 + variant_max_sizeof< V >::value >::type storage_type;
+    typedef typename storage_type::word_type word_type;
+    typedef variants::detail::packed_variant< V, word_type > packed;
+
+public:
+    typedef V value_type;
+
+    static constexpr bool is_always_lock_free = storage_type::is_always_lock_free;
+
+    atomic_variant() noexcept
+        : storage_( packed::pack( V() ) ) {}
+
+    explicit atomic_variant( V const & v ) noexcept
+        : storage_( packed::pack( v ) ) {}
+
+    atomic_variant( atomic_variant const & ) = delete;
+    atomic_variant & operator=( atomic_variant const & ) = delete;
+
+    V operator=( V const & v ) noexcept
+    {
+        store( v );
+        return v;
+    }
+
+    operator V() const noexcept
+    {
+        return load();
+    }
+
+    bool is_lock_free() const noexcept
+    {
+        return storage_.is_lock_free();
+    }
+
+    V load( std::memory_order order = std::memory_order_seq_cst ) const noexcept
+    {
+        return packed::unpack( storage_.load( order ) );
+    }
+
+    // index of the current value:
+
+    std::size_t index( std::memory_order order = std::memory_order_seq_cst ) const noexcept
+    {
+        return packed::index( storage_.load( order ) );
+    }
+
+    void store( V const & v, std::memory_order order = std::memory_order_seq_cst ) noexcept
+    {
+        storage_.store( packed::pack( v ), order );
+    }
+
+    V exchange( V const & v, std::memory_order order = std::memory_order_seq_cst ) noexcept
+    {
+        return packed::unpack( storage_.exchange( packed::pack( v ), order ) );
+    }
+
+    bool compare_exchange_weak( V & expected, V const & desired, std::memory_order success, std::memory_order failure ) noexcept
+    {
+        word_type word = packed::pack( expected );
+
+        if ( storage_.compare_exchange_weak( word, packed::pack( desired ), success, failure ) )
+        {
+            return true;
+        }
+        expected = packed::unpack( word );
+        return false;
+    }
+
+    bool compare_exchange_weak( V & expected, V const & desired, std::memory_order order = std::memory_order_seq_cst ) noexcept
+    {
+        return compare_exchange_weak( expected, desired, order, failure_order( order ) );
+    }
+
+    bool compare_exchange_strong( V & expected, V const & desired, std::memory_order success, std::memory_order failure ) noexcept
+    {
+        word_type word = packed::pack( expected );
+
+        if ( storage_.compare_exchange_strong( word, packed::pack( desired ), success, failure ) )
+        {
+            return true;
+        }
+        expected = packed::unpack( word );
+        return false;
+    }
+
+    bool compare_exchange_strong( V & expected, V const & desired, std::memory_order order = std::memory_order_seq_cst ) noexcept
+    {
+        return compare_exchange_strong( expected, desired, order, failure_order( order ) );
+    }
+
+    // call f with the current value, without constructing a variant:
+
+    template< class F >
+    auto visit_current( F && f, std::memory_order order = std::memory_order_seq_cst ) const
+        -> decltype( f( std::declval< typename variant_alternative< 0, V >::type const & >() ) )
+    {
+        return packed::visit( storage_.load( order ), f );
+    }
+
+private:
+    static constexpr std::memory_order failure_order( std::memory_order order ) noexcept
+    {
+        return order == std::memory_order_acq_rel ? std::memory_order_acquire
+            :  order == std::memory_order_release ? std::memory_order_relaxed : order;
+    }
+
+private:
+    storage_type storage_;
+};
+
+#if ! variant_CPP17_OR_GREATER
+
+template< class V >
+constexpr bool atomic_variant< V >::is_always_lock_free;
+
+#endif
+
+} // namespace nonstd
+
+#endif // variant_CPP11_OR_GREATER
+
+#endif // NONSTD_VARIANT_ATOMIC_HPP
@@ -0,0 +1,421 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Formatting of variants into a caller-provided buffer, without iostreams
+// (C++11 and later).
+//
+// format_to() dispatches on the index once and writes the contained value via
+// variant_formatter<T>. Numbers use std::to_chars() where available, which is
+// locale-independent; otherwise integers are converted by hand and floating
+// point values via snprintf(). With nonstd::variant, a std::formatter (C++20)
+// and a fmt::formatter (if {fmt} is included before this header) are provided.
+
+#pragma once
+
+#ifndef NONSTD_VARIANT_FORMAT_HPP
+#define NONSTD_VARIANT_FORMAT_HPP
+
+#include "variant_util.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+
+#if variant_CPP17_OR_GREATER && defined( __has_include )
+# if __has_include( <charconv> )
+#  include <charconv>
+#  define variant_HAVE_CHARCONV  1
+# endif
+# if __has_include( <string_view> )
+#  include <string_view>
+#  define variant_HAVE_STRING_VIEW  1
+# endif
+#endif
+
+#if ! variant_USES_STD_VARIANT && variant_CPP20_OR_GREATER && defined( __has_include )
+# if __has_include( <format> )
+#  include <format>
+# endif
+#endif
+
+#ifndef variant_HAVE_CHARCONV
+# define variant_HAVE_CHARCONV  0
+#endif
+
+#ifndef variant_HAVE_STRING_VIEW
+# define variant_HAVE_STRING_VIEW  0
+#endif
+
+#if variant_HAVE_CHARCONV && defined( __cpp_lib_to_chars )
+# define variant_HAVE_FP_TO_CHARS  1
+#else
+# define variant_HAVE_FP_TO_CHARS  0
+#endif
+
+// non-standard: largest buffer format_to() to an output iterator tries:
+
+#ifndef variant_CONFIG_FORMAT_MAX_SIZE
+# define variant_CONFIG_FORMAT_MAX_SIZE  ( 1024 * 1024 )
+#endif
+
+namespace nonstd {
+namespace variants {
+namespace detail {
+
+// copy n characters to [first, last); return past them, or nullptr if they do not fit:
+
+inline char * format_chars( char const * text, std::size_t n, char * first, char * last ) noexcept
+{
+    if ( n > static_cast<std::size_t>( last - first ) )
+    {
+        return nullptr;
+    }
+    return std::copy( text, text + n, first );
+}
+
+#if variant_HAVE_CHARCONV
+
+template< class T >
+inline char * format_integer( T value, char * first, char * last ) noexcept
+{
+    std::to_chars_result const result = std::to_chars( first, last, value );
+
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+#else // variant_HAVE_CHARCONV
+
+template< class T >
+inline bool is_negative( T value, std::true_type /*is_signed*/ ) noexcept
+{
+    return value < 0;
+}
+
+template< class T >
+inline bool is_negative( T, std::false_type /*is_signed*/ ) noexcept
+{
+    return false;
+}
+
+template< class T >
+inline char * format_integer( T value, char * first, char * last ) noexcept
+{
+    typedef typename std::make_unsigned<T>::type unsigned_type;
+
+    char digits[ std::numeric_limits<unsigned_type>::digits10 + 2 ];
+    char * const end = digits + sizeof( digits );
+    char * pos = end;
+
+    bool const negative = is_negative( value, std::is_signed<T>() );
+
+    unsigned_type magnitude = negative
+        ? static_cast<unsigned_type>( unsigned_type( 0 ) - static_cast<unsigned_type>( value ) )
+        : static_cast<unsigned_type>( value );
+
+    do
+    {
+        *--pos = static_cast<char>( '0' + magnitude % 10 );
+    }
+    while ( ( magnitude /= 10 ) != 0 );
+
+    if ( negative )
+    {
+        *--pos = '-';
+    }
+    return format_chars( pos, static_cast<std::size_t>( end - pos ), first, last );
+}
+
+#endif // variant_HAVE_CHARCONV
+
+#if variant_HAVE_FP_TO_CHARS
+
+template< class T >
+inline char * format_floating( T value, char * first, char * last ) noexcept
+{
+    std::to_chars_result const result = std::to_chars( first, last, value );
+
+    return result.ec == std::errc() ? result.ptr : nullptr;
+}
+
+#else // variant_HAVE_FP_TO_CHARS
+
+inline char * format_printed( int n, char const * buffer, char * first, char * last ) noexcept
+{
+    return n < 0 ? nullptr : format_chars( buffer, static_cast<std::size_t>( n ), first, last );
+}
+
+inline char * format_floating( double value, char * first, char * last ) noexcept
+{
+    char buffer[ 64 ];
+
+    return format_printed( std::snprintf( buffer, sizeof( buffer ), "%.*g", std::numeric_limits<double>::max_digits10, value ), buffer, first, last );
+}
+
+inline char * format_floating( float value, char * first, char * last ) noexcept
+{
+    char buffer[ 64 ];
+
+    return format_printed( std::snprintf( buffer, sizeof( buffer ), "%.*g", std::numeric_limits<float>::max_digits10, static_cast<double>( value ) ), buffer, first, last );
+}
+
+inline char * format_floating( long double value, char * first, char * last ) noexcept
+{
+    char buffer[ 64 ];
+
+    return format_printed( std::snprintf( buffer, sizeof( buffer ), "%.*Lg", std::numeric_limits<long double>::max_digits10, value ), buffer, first, last );
+}
+
+#endif // variant_HAVE_FP_TO_CHARS
+
+} // namespace detail
+} // namespace variants
+
+// non-standard: per-alternative formatter; specialize for your own types.
+//
+// A formatter provides:
+// - static char * format( T const & value, char * first, char * last ):
+//   write value to [first, last); return past the characters written, or
+//   nullptr if they do not fit.
+
+template< class T, class Enable = void >
+struct variant_formatter;
+
+template<>
+struct variant_formatter< monostate >
+{
+    static char * format( monostate const &, char * first, char * last ) noexcept
+    {
+        return variants::detail::format_chars( "monostate", 9, first, last );
+    }
+};
+
+template<>
+struct variant_formatter< bool >
+{
+    static char * format( bool value, char * first, char * last ) noexcept
+    {
+        return value
+            ? variants::detail::format_chars( "true" , 4, first, last )
+            : variants::detail::format_chars( "false", 5, first, last );
+    }
+};
+
+template<>
+struct variant_formatter< char >
+{
+    static char * format( char value, char * first, char * last ) noexcept
+    {
+        return variants::detail::format_chars( &value, 1, first, last );
+    }
+};
+
+namespace variants {
+namespace detail {
+
+template< class T >
+struct is_integer_number : std::integral_constant< bool,
+    std::is_integral<T>::value
+    && ! std::is_same<T, bool    >::value && ! std::is_same<T, char    >::value
+    && ! std::is_same<T, wchar_t >::value && ! std::is_same<T, char16_t>::value
+    && ! std::is_same<T, char32_t>::value > {};
+
+} // namespace detail
+} // namespace variants
+
+template< class T >
+struct variant_formatter< T, typename std::enable_if< variants::detail::is_integer_number<T>::value >::type >
+{
+    static char * format( T value, char * first, char * last ) noexcept
+    {
+        return variants::detail::format_integer( value, first, last );
+    }
+};
+
+template< class T >
+struct variant_formatter< T, typename std::enable_if< std::is_enum<T>::value >::type >
+{
+    static char * format( T value, char * first, char * last ) noexcept
+    {
+        return variants::detail::format_integer( static_cast< typename std::underlying_type<T>::type >( value ), first, last );
+    }
+};
+
+template< class T >
+struct variant_formatter< T, typename std::enable_if< std::is_floating_point<T>::value >::type >
+{
+    static char * format( T value, char * first, char * last ) noexcept
+    {
+        return variants::detail::format_floating( value, first, last );
+    }
+};
+
+template<>
+struct variant_formatter< char const * >
+{
+    static char * format( char const * value, char * first, char * last ) noexcept
+    {
+        return value
+            ? variants::detail::format_chars( value, std::strlen( value ), first, last )
+            : variants::detail::format_chars( "(null)", 6, first, last );
+    }
+};
+
+template<>
+struct variant_formatter< char * > : variant_formatter< char const * > {};
+
+template< class Traits, class Allocator >
+struct variant_formatter< std::basic_string< char, Traits, Allocator > >
+{
+    static char * format( std::basic_string< char, Traits, Allocator > const & value, char * first, char * last ) noexcept
+    {
+        return variants::detail::format_chars( value.data(), value.size(), first, last );
+    }
+};
+
+#if variant_HAVE_STRING_VIEW
+
+template< class Traits >
+struct variant_formatter< std::basic_string_view< char, Traits > >
+{
+    static char * format( std::basic_string_view< char, Traits > value, char * first, char * last ) noexcept
+    {
+        return variants::detail::format_chars( value.data(), value.size(), first, last );
+    }
+};
+
+#endif // variant_HAVE_STRING_VIEW
+
+namespace variants {
+namespace detail {
+
+template< class V >
+struct format_alternative
+{
+    V const & v;
+    char * first;
+    char * last;
+
+    template< std::size_t K >
+    char * operator()( std::integral_constant< std::size_t, K > ) const
+    {
+        typedef typename variant_alternative< K, V >::type type;
+
+        return variant_formatter< type >::format( *nonstd::get_if<K>( &v ), first, last );
+    }
+};
+
+} // namespace detail
+} // namespace variants
+
+// non-standard: write the value of v to [buffer, buffer + size), or "valueless"
+// for a valueless variant; return past the characters written, or nullptr if
+// they do not fit. No terminating null character is written:
+
+template< class V >
+inline char * format_to( char * buffer, std::size_t size, V const & v )
+{
+    if ( v.valueless_by_exception() )
+    {
+        return variants::detail::format_chars( "valueless", 9, buffer, buffer + size );
+    }
+
+    variants::detail::format_alternative< V > const format = { v, buffer, buffer + size };
+
+    return with_index< variant_size<V>::value >( v.index(), format );
+}
+
+// non-standard: write the value of v to out, formatting it in a buffer on the
+// stack, or on the heap if the stack buffer is too small; return out past it.
+// If it does not fit in variant_CONFIG_FORMAT_MAX_SIZE characters, or its
+// formatter fails otherwise, nothing is written and out is returned:
+
+template< class OutputIt, class V >
+inline OutputIt format_to( OutputIt out, V const & v )
+{
+    char buffer[ 128 ];
+
+    if ( char * end = nonstd::format_to( buffer, sizeof( buffer ), v ) )
+    {
+        return std::copy( buffer, end, out );
+    }
+
+    std::size_t const max_size = variant_CONFIG_FORMAT_MAX_SIZE;
+
+    for ( std::size_t size = 2 * sizeof( buffer ); size <= max_size; size *= 2 )
+    {
+        std::string text( size, '\0' );
+
+        if ( char * end = nonstd::format_to( &text[0], text.size(), v ) )
+        {
+            return std::copy( &text[0], end, out );
+        }
+    }
+    return out;
+}
+
+} // namespace nonstd
+
+// std::format and {fmt} support for nonstd::variant:
+
+#if ! variant_USES_STD_VARIANT
+
+#if defined( __cpp_lib_format )
+
+namespace std {
+
+template< class... Ts >
+struct formatter< nonstd::variants::variant< Ts... >, char >
+{
+    constexpr auto parse( std::format_parse_context & ctx ) -> decltype( ctx.begin() )
+    {
+        return ctx.begin();
+    }
+
+    template< class FormatContext >
+    auto format( nonstd::variants::variant< Ts... > const & v, FormatContext & ctx ) const -> decltype( ctx.out() )
+    {
+        return nonstd::format_to( ctx.out(), v );
+    }
+};
+
+} // namespace std
+
+#endif // __cpp_lib_format
+
+#if defined( FMT_VERSION )
+
+namespace fmt {
+
+template< class... Ts >
+struct formatter< nonstd::variants::variant< Ts... >, char >
+{
+    template< class ParseContext >
+    constexpr auto parse( ParseContext & ctx ) -> decltype( ctx.begin() )
+    {
+        return ctx.begin();
+    }
+
+    template< class FormatContext >
+    auto format( nonstd::variants::variant< Ts... > const & v, FormatContext & ctx ) const -> decltype( ctx.out() )
+    {
+        return nonstd::format_to( ctx.out(), v );
+    }
+};
+
+} // namespace fmt
+
+#endif // FMT_VERSION
+
+#endif // ! variant_USES_STD_VARIANT
+
+#endif // variant_CPP11_OR_GREATER
+
+#endif // NONSTD_VARIANT_FORMAT_HPP
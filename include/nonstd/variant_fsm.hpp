@@ -0,0 +1,232 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Finite state machine with its state in a variant (C++11 and later).
+//
+// fsm<States, Events, Transitions> resolves a (state, Events variant) pair via
+// one flattened [state][event] table of function pointers, built at compile
+// time; for an event of static type, the state's entry is selected with direct
+// calls that the optimizer can inline. Each entry calls Transitions::on_event(
+// state &, event const & ) and, if that returns a new state, move-constructs it
+// into the state variant: on_event() reads the current state, which emplace()
+// destroys before it constructs the next one, so the next state cannot be
+// constructed in place and costs one move per transition. There is no optional
+// and no copy of the state variant; the machine does not allocate.
+
+#pragma once
+
+#ifndef NONSTD_VARIANT_FSM_HPP
+#define NONSTD_VARIANT_FSM_HPP
+
+#include "variant_util.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+namespace nonstd {
+
+// non-standard: on_event() result that leaves the state machine in its state:
+
+struct fsm_stay {};
+
+namespace variants {
+namespace detail {
+
+// marks a (state, event) pair without on_event() overload:
+
+struct fsm_unhandled {};
+
+template< class T >
+struct fsm_void
+{
+    typedef void type;
+};
+
+template< class T, class S, class E, class = void >
+struct fsm_result
+{
+    typedef fsm_unhandled type;
+};
+
+template< class T, class S, class E >
+struct fsm_result< T, S, E, typename fsm_void< decltype(
+    std::declval<T &>().on_event( std::declval<S &>(), std::declval<E const &>() ) ) >::type >
+{
+    typedef decltype( std::declval<T &>().on_event( std::declval<S &>(), std::declval<E const &>() ) ) type;
+};
+
+// take the transition for on_event() result R; return true if the state changed:
+
+template< class States, class R >
+struct fsm_step
+{
+    template< class T, class S, class E >
+    static bool apply( T & transitions, States & states, S & state, E const & event )
+    {
+        // on_event() computes the next state before emplace() ends the current one;
+        // emplace() then move-constructs it into the variant:
+
+        states.template emplace< variant_index_of< R, States >::value >( transitions.on_event( state, event ) );
+        return true;
+    }
+};
+
+template< class States >
+struct fsm_step< States, fsm_unhandled >
+{
+    template< class T, class S, class E >
+    static bool apply( T &, States &, S &, E const & )
+    {
+        return false;
+    }
+};
+
+template< class States >
+struct fsm_step< States, fsm_stay >
+{
+    template< class T, class S, class E >
+    static bool apply( T & transitions, States &, S & state, E const & event )
+    {
+        transitions.on_event( state, event );
+        return false;
+    }
+};
+
+template< class States >
+struct fsm_step< States, void > : fsm_step< States, fsm_stay > {};
+
+} // namespace detail
+} // namespace variants
+
+// non-standard: finite state machine; States and Events are variants, Transitions
+// provides on_event( S &, E const & ) overloads that return the next state, or
+// fsm_stay or void to remain in S. Pairs without overload leave the state as is:
+
+template< class States, class Events, class Transitions >
+class fsm
+{
+    static constexpr std::size_t state_count = variant_size< States >::value;
+    static constexpr std::size_t event_count = variant_size< Events >::value;
+
+    typedef bool ( * entry )( Transitions &, States &, Events const & );
+
+public:
+    typedef States      state_type;
+    typedef Events      event_type;
+    typedef Transitions transitions_type;
+
+    fsm()
+        : transitions_(), state_() {}
+
+    explicit fsm( States const & initial, Transitions const & transitions = Transitions() )
+        : transitions_( transitions ), state_( initial ) {}
+
+    States const & state() const noexcept
+    {
+        return state_;
+    }
+
+    template< class S >
+    bool is_in() const noexcept
+    {
+        return state_.index() == variant_index_of< S, States >::value;
+    }
+
+    Transitions & transitions() noexcept
+    {
+        return transitions_;
+    }
+
+    Transitions const & transitions() const noexcept
+    {
+        return transitions_;
+    }
+
+    // handle an event of type E, an alternative of Events; return true if the state changed.
+    // As the event column is known, its entry is selected with direct calls:
+
+    template< class E >
+    bool dispatch( E const & event )
+    {
+        static_assert( variant_index_of< E, Events >::value < event_count
+            , "fsm: event type is not an alternative of Events." );
+
+        if ( state_.valueless_by_exception() )
+        {
+            return false;
+        }
+
+        typed_step< E > const step = { transitions_, state_, event };
+
+        return with_index< state_count >( state_.index(), step );
+    }
+
+    // handle the event held by an Events variant via the [state][event] table;
+    // return true if the state changed:
+
+    bool dispatch( Events const & event )
+    {
+        if ( state_.valueless_by_exception() || event.valueless_by_exception() )
+        {
+            return false;
+        }
+
+        typedef typename variants::detail::make_index_list< state_count * event_count >::type entry_indices;
+
+        entry const * const entries = table( entry_indices() );
+
+        return entries[ state_.index() * event_count + event.index() ]( transitions_, state_, event );
+    }
+
+private:
+    template< std::size_t S, class E >
+    static bool transit( Transitions & transitions, States & states, E const & event )
+    {
+        typedef typename variant_alternative< S, States >::type state_alternative;
+        typedef typename variants::detail::fsm_result< Transitions, state_alternative, E >::type result;
+
+        return variants::detail::fsm_step< States, result >::apply(
+            transitions, states, *nonstd::get_if<S>( &states ), event );
+    }
+
+    template< class E >
+    struct typed_step
+    {
+        Transitions & transitions;
+        States & states;
+        E const & event;
+
+        template< std::size_t S >
+        bool operator()( std::integral_constant< std::size_t, S > ) const
+        {
+            return transit< S >( transitions, states, event );
+        }
+    };
+
+    template< std::size_t S, std::size_t E >
+    static bool table_entry( Transitions & transitions, States & states, Events const & event )
+    {
+        return transit< S >( transitions, states, *nonstd::get_if<E>( &event ) );
+    }
+
+    template< std::size_t... I >
+    static entry const * table( variants::detail::index_list< I... > ) noexcept
+    {
+        static constexpr entry entries[] = { &table_entry< I / event_count, I % event_count >... };
+
+        return entries;
+    }
+
+private:
+    Transitions transitions_;
+    States state_;
+};
+
+} // namespace nonstd
+
+#endif // variant_CPP11_OR_GREATER
+
+#endif // NONSTD_VARIANT_FSM_HPP
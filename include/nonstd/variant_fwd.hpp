@@ -0,0 +1,227 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Declarations of variant with its default template arguments, monostate,
+// variant_size, variant_alternative and bad_variant_access, for headers that
+// only name these types. Include nonstd/variant.hpp to use them.
+// Generated with nonstd/variant.hpp by script/generate_header.py.
+
+#pragma once
+
+#ifndef NONSTD_VARIANT_LITE_FWD_HPP
+#define NONSTD_VARIANT_LITE_FWD_HPP
+
+// variant-lite version and configuration, also in nonstd/variant_fwd.hpp:
+
+#ifndef NONSTD_VARIANT_LITE_CONFIG
+#define NONSTD_VARIANT_LITE_CONFIG
+
+#define variant_lite_MAJOR  3
+#define variant_lite_MINOR  0
+#define variant_lite_PATCH  0
+
+#define variant_lite_VERSION  variant_STRINGIFY(variant_lite_MAJOR) "." variant_STRINGIFY(variant_lite_MINOR) "." variant_STRINGIFY(variant_lite_PATCH)
+
+#define variant_STRINGIFY(  x )  variant_STRINGIFY_( x )
+#define variant_STRINGIFY_( x )  #x
+
+// variant-lite configuration:
+
+#define variant_VARIANT_DEFAULT  0
+#define variant_VARIANT_NONSTD   1
+#define variant_VARIANT_STD      2
+
+// tweak header support:
+
+#ifdef __has_include
+# if __has_include(<nonstd/variant.tweak.hpp>)
+#  include <nonstd/variant.tweak.hpp>
+# endif
+#define variant_HAVE_TWEAK_HEADER  1
+#else
+#define variant_HAVE_TWEAK_HEADER  0
+//# pragma message("variant.hpp: Note: Tweak header not supported.")
+#endif
+
+// variant selection and configuration:
+
+#ifndef  variant_CONFIG_OMIT_VARIANT_SIZE_V_MACRO
+# define variant_CONFIG_OMIT_VARIANT_SIZE_V_MACRO  0
+#endif
+
+#ifndef  variant_CONFIG_OMIT_VARIANT_ALTERNATIVE_T_MACRO
+# define variant_CONFIG_OMIT_VARIANT_ALTERNATIVE_T_MACRO  0
+#endif
+
+// Control marking class bad_variant_access with [[nodiscard]]]:
+
+#if !defined(variant_CONFIG_NO_NODISCARD)
+# define variant_CONFIG_NO_NODISCARD  0
+#else
+# define variant_CONFIG_NO_NODISCARD  1
+#endif
+
+// Control presence of exception handling (try and auto discover):
+
+#ifndef variant_CONFIG_NO_EXCEPTIONS
+# if defined(_MSC_VER)
+#  include <cstddef>    // for _HAS_EXCEPTIONS
+# endif
+# if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || (_HAS_EXCEPTIONS)
+#  define variant_CONFIG_NO_EXCEPTIONS  0
+# else
+#  define variant_CONFIG_NO_EXCEPTIONS  1
+# endif
+#endif
+
+// C++ language version detection (C++23 is speculative):
+// Note: VC14.0/1900 (VS2015) lacks too much from C++14.
+
+#ifndef   variant_CPLUSPLUS
+# if defined(_MSVC_LANG ) && !defined(__clang__)
+#  define variant_CPLUSPLUS  (_MSC_VER == 1900 ? 201103L : _MSVC_LANG )
+# else
+#  define variant_CPLUSPLUS  __cplusplus
+# endif
+#endif
+
+#define variant_CPP98_OR_GREATER  ( variant_CPLUSPLUS >= 199711L )
+#define variant_CPP11_OR_GREATER  ( variant_CPLUSPLUS >= 201103L )
+#define variant_CPP11_OR_GREATER_ ( variant_CPLUSPLUS >= 201103L )
+#define variant_CPP14_OR_GREATER  ( variant_CPLUSPLUS >= 201402L )
+#define variant_CPP17_OR_GREATER  ( variant_CPLUSPLUS >= 201703L )
+#define variant_CPP20_OR_GREATER  ( variant_CPLUSPLUS >= 202002L )
+#define variant_CPP23_OR_GREATER  ( variant_CPLUSPLUS >= 202300L )
+
+// Use C++17 std::variant if available and requested:
+
+#if variant_CPP17_OR_GREATER && defined(__has_include )
+# if __has_include( <variant> )
+#  define variant_HAVE_STD_VARIANT  1
+# else
+#  define variant_HAVE_STD_VARIANT  0
+# endif
+#else
+# define  variant_HAVE_STD_VARIANT  0
+#endif
+
+#if !defined( variant_CONFIG_SELECT_VARIANT )
+# define variant_CONFIG_SELECT_VARIANT  ( variant_HAVE_STD_VARIANT ? variant_VARIANT_STD : variant_VARIANT_NONSTD )
+#endif
+
+#define  variant_USES_STD_VARIANT  ( (variant_CONFIG_SELECT_VARIANT == variant_VARIANT_STD) || ((variant_CONFIG_SELECT_VARIANT == variant_VARIANT_DEFAULT) && variant_HAVE_STD_VARIANT) )
+
+#endif // NONSTD_VARIANT_LITE_CONFIG
+
+#if variant_USES_STD_VARIANT
+
+#include <variant>
+
+namespace nonstd {
+
+    using std::variant;
+    using std::monostate;
+    using std::bad_variant_access;
+    using std::variant_size;
+    using std::variant_alternative;
+}
+
+#else // variant_USES_STD_VARIANT
+
+#include <cstddef>
+
+namespace nonstd { namespace variants {
+
+// variant with its default template arguments, also in nonstd/variant_fwd.hpp;
+// default template arguments can be given only once:
+
+#ifndef NONSTD_VARIANT_LITE_FWD_DECLARATIONS
+#define NONSTD_VARIANT_LITE_FWD_DECLARATIONS
+
+namespace detail {
+
+template< class T > struct TX;
+
+struct S0; typedef TX<S0> T0;
+struct S1; typedef TX<S1> T1;
+struct S2; typedef TX<S2> T2;
+struct S3; typedef TX<S3> T3;
+struct S4; typedef TX<S4> T4;
+struct S5; typedef TX<S5> T5;
+struct S6; typedef TX<S6> T6;
+struct S7; typedef TX<S7> T7;
+struct S8; typedef TX<S8> T8;
+struct S9; typedef TX<S9> T9;
+struct S10; typedef TX<S10> T10;
+struct S11; typedef TX<S11> T11;
+struct S12; typedef TX<S12> T12;
+struct S13; typedef TX<S13> T13;
+struct S14; typedef TX<S14> T14;
+struct S15; typedef TX<S15> T15;
+
+} // namespace detail
+
+template<
+    class T0,
+    class T1 = detail::T1,
+    class T2 = detail::T2,
+    class T3 = detail::T3,
+    class T4 = detail::T4,
+    class T5 = detail::T5,
+    class T6 = detail::T6,
+    class T7 = detail::T7,
+    class T8 = detail::T8,
+    class T9 = detail::T9,
+    class T10 = detail::T10,
+    class T11 = detail::T11,
+    class T12 = detail::T12,
+    class T13 = detail::T13,
+    class T14 = detail::T14,
+    class T15 = detail::T15
+    >
+class variant;
+
+#endif // NONSTD_VARIANT_LITE_FWD_DECLARATIONS
+
+#ifdef variant_CONFIG_OVERRIDE_MONOSTATE
+using variant_CONFIG_OVERRIDE_MONOSTATE;
+#else
+class monostate;
+#endif
+
+template< class T >
+struct variant_size;
+
+template< std::size_t K, class T >
+struct variant_alternative;
+
+#if ! variant_CONFIG_NO_EXCEPTIONS
+# ifdef variant_CONFIG_OVERRIDE_BAD_VARIANT_ACCESS
+using variant_CONFIG_OVERRIDE_BAD_VARIANT_ACCESS;
+# else
+class bad_variant_access;
+# endif
+#endif
+
+} // namespace variants
+
+// using-declarations: a using-directive here would make variants::detail
+// collide with nonstd::detail of nonstd/variant.hpp:
+
+using variants::variant;
+using variants::monostate;
+using variants::variant_size;
+using variants::variant_alternative;
+#if ! variant_CONFIG_NO_EXCEPTIONS
+using variants::bad_variant_access;
+#endif
+
+} // namespace nonstd
+
+#endif // variant_USES_STD_VARIANT
+
+#endif // NONSTD_VARIANT_LITE_FWD_HPP
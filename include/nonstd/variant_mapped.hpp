@@ -0,0 +1,378 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Memory-mappable layout for arrays of variants with trivially copyable
+// alternatives (C++11 and later).
+//
+// Layout, all offsets in bytes from the start of the mapping, which must be
+// aligned to mapped_variant_layout<V>::alignment (a page-aligned mmap is):
+//
+//   [0, 64)                  mapped_variant_header, see below
+//   [index_offset, +count)   one unsigned byte per element: its index
+//   [payload_offset, ...)    count slots of payload_stride bytes, slot i holds
+//                            the object representation of element i's value,
+//                            payload_offset is a multiple of alignment
+//
+// Padding bytes are zero. Integers in the header are in the byte order of the
+// writer, which is recorded in byte_order; a reader with another byte order,
+// alternative set or layout rejects the data.
+
+#pragma once
+
+#ifndef NONSTD_VARIANT_MAPPED_HPP
+#define NONSTD_VARIANT_MAPPED_HPP
+
+#include "variant_util.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+namespace nonstd {
+
+// non-standard: specialize to tell apart alternatives of the same size, alignment
+// and kind, such as two structs with two ints, in the layout fingerprint:
+
+template< class T >
+struct variant_mapped_tag : std::integral_constant< std::uint64_t, 0 > {};
+
+// non-standard: file header of the mapped layout:
+
+struct mapped_variant_header
+{
+    char          magic[8];         // "nsvarmap"
+    std::uint32_t version;          // 1
+    std::uint32_t byte_order;       // 0x01020304
+    std::uint64_t fingerprint;      // variant_fingerprint<V>
+    std::uint64_t count;            // number of elements
+    std::uint32_t index_width;      // bytes per index: 1
+    std::uint32_t alignment;        // alignment of the mapping and the payloads
+    std::uint32_t payload_stride;   // bytes per payload slot
+    std::uint32_t reserved;         // 0
+    std::uint64_t index_offset;     // 64
+    std::uint64_t payload_offset;   // start of the payload slots
+};
+
+static_assert( sizeof( mapped_variant_header ) == 64, "mapped_variant_header must occupy 64 bytes." );
+
+namespace variants {
+namespace detail {
+
+// FNV-1a over 64-bit words:
+
+constexpr std::uint64_t fingerprint_mix( std::uint64_t hash, std::uint64_t word )
+{
+    return ( hash ^ word ) * 0x100000001b3ull;
+}
+
+template< class T >
+constexpr std::uint64_t alternative_kind()
+{
+    return std::is_empty<T>::value          ? 1
+        :  std::is_enum<T>::value           ? 2
+        :  std::is_floating_point<T>::value ? 3
+        :  std::is_integral<T>::value       ? ( std::is_signed<T>::value ? 4 : 5 )
+        :  std::is_pointer<T>::value        ? 6
+        :  std::is_array<T>::value          ? 7 : 8;
+}
+
+template< class V, std::size_t K = variant_size<V>::value >
+struct alternatives_fingerprint
+{
+    typedef typename variant_alternative< K - 1, V >::type type;
+
+    static constexpr std::uint64_t value =
+        fingerprint_mix( fingerprint_mix( fingerprint_mix( fingerprint_mix(
+            alternatives_fingerprint< V, K - 1 >::value, sizeof( type ) ), alignof( type ) ),
+                alternative_kind< type >() ), variant_mapped_tag< type >::value );
+};
+
+template< class V >
+struct alternatives_fingerprint< V, 0 >
+{
+    static constexpr std::uint64_t value = fingerprint_mix( 0xcbf29ce484222325ull, variant_size<V>::value );
+};
+
+constexpr std::size_t round_up( std::size_t size, std::size_t alignment )
+{
+    return ( size + alignment - 1 ) / alignment * alignment;
+}
+
+template< class V >
+struct mapped_store
+{
+    V const & v;
+    unsigned char * out;
+
+    template< std::size_t K >
+    void operator()( std::integral_constant< std::size_t, K > ) const
+    {
+        typedef typename variant_alternative< K, V >::type type;
+
+        std::memcpy( out, nonstd::get_if<K>( &v ), sizeof( type ) );
+    }
+};
+
+template< class V >
+struct mapped_load
+{
+    unsigned char const * slot;
+
+    template< std::size_t K >
+    V operator()( std::integral_constant< std::size_t, K > ) const
+    {
+        typedef typename variant_alternative< K, V >::type type;
+
+        return V( nonstd_lite_in_place_index(K), *reinterpret_cast<type const *>( slot ) );
+    }
+};
+
+template< class V, class F >
+struct mapped_visit
+{
+    unsigned char const * slot;
+    F & f;
+
+    template< std::size_t K >
+    auto operator()( std::integral_constant< std::size_t, K > ) const
+        -> decltype( f( std::declval< typename variant_alternative< 0, V >::type const & >() ) )
+    {
+        typedef typename variant_alternative< K, V >::type type;
+
+        return f( *reinterpret_cast<type const *>( slot ) );
+    }
+};
+
+} // namespace detail
+} // namespace variants
+
+// non-standard: fingerprint of the alternative set of V as stored in the header:
+
+template< class V >
+struct variant_fingerprint : std::integral_constant< std::uint64_t, variants::detail::alternatives_fingerprint< V >::value > {};
+
+// non-standard: sizes and offsets of the mapped layout for V:
+
+template< class V >
+struct mapped_variant_layout
+{
+    static_assert( variant_is_trivially_copyable< V >::value, "mapped layout requires trivially copyable alternatives." );
+    static_assert( variant_size< V >::value <= 255, "mapped layout supports at most 255 alternatives." );
+
+    static constexpr std::size_t alignment      = variant_max_alignof< V >::value > 8 ? variant_max_alignof< V >::value : 8;
+    static constexpr std::size_t payload_stride = variants::detail::round_up( variant_max_sizeof< V >::value, variant_max_alignof< V >::value );
+    static constexpr std::size_t index_offset   = sizeof( mapped_variant_header );
+
+    static constexpr std::size_t payload_offset( std::size_t count )
+    {
+        return variants::detail::round_up( index_offset + count, alignment );
+    }
+
+    static constexpr std::size_t size( std::size_t count )
+    {
+        return payload_offset( count ) + count * payload_stride;
+    }
+};
+
+// non-standard: number of bytes write_mapped() writes for count variants:
+
+template< class V >
+inline std::size_t mapped_size( std::size_t count ) noexcept
+{
+    return mapped_variant_layout< V >::size( count );
+}
+
+// non-standard: write the variants in [first, last) to out, which must provide
+// mapped_size<V>( std::distance( first, last ) ) bytes; return past the bytes
+// written, or nullptr if the sequence contains a valueless variant:
+
+template< class ForwardIt >
+inline char * write_mapped( ForwardIt first, ForwardIt last, char * out )
+{
+    typedef typename std::iterator_traits< ForwardIt >::value_type V;
+    typedef mapped_variant_layout< V > layout;
+
+    std::size_t const count = static_cast<std::size_t>( std::distance( first, last ) );
+
+    std::memset( out, 0, layout::size( count ) );
+
+    mapped_variant_header header = {};
+
+    std::memcpy( header.magic, "nsvarmap", sizeof( header.magic ) );
+    header.version        = 1;
+    header.byte_order     = 0x01020304;
+    header.fingerprint    = variant_fingerprint< V >::value;
+    header.count          = count;
+    header.index_width    = 1;
+    header.alignment      = static_cast<std::uint32_t>( layout::alignment );
+    header.payload_stride = static_cast<std::uint32_t>( layout::payload_stride );
+    header.index_offset   = layout::index_offset;
+    header.payload_offset = layout::payload_offset( count );
+
+    std::memcpy( out, &header, sizeof( header ) );
+
+    unsigned char * index   = reinterpret_cast<unsigned char *>( out + layout::index_offset );
+    unsigned char * payload = reinterpret_cast<unsigned char *>( out + layout::payload_offset( count ) );
+
+    for ( ; first != last; ++first, ++index, payload += layout::payload_stride )
+    {
+        if ( first->valueless_by_exception() )
+        {
+            return nullptr;
+        }
+
+        variants::detail::mapped_store< V > const store = { *first, payload };
+
+        *index = static_cast<unsigned char>( first->index() );
+        with_index< variant_size<V>::value >( first->index(), store );
+    }
+    return out + layout::size( count );
+}
+
+// non-standard: read-only view of variants in the mapped layout; the header is
+// validated once on construction, after which the elements are accessed in place:
+
+template< class V >
+class mapped_variant_span
+{
+    typedef mapped_variant_layout< V > layout;
+
+public:
+    typedef V           value_type;
+    typedef std::size_t size_type;
+
+    mapped_variant_span() noexcept
+        : index_( nullptr )
+        , payload_( nullptr )
+        , count_( 0 )
+    {}
+
+    // an invalid, empty view results if [data, data + size) does not hold
+    // a complete, properly aligned mapping written for V:
+
+    mapped_variant_span( void const * data, std::size_t size ) noexcept
+        : index_( nullptr )
+        , payload_( nullptr )
+        , count_( 0 )
+    {
+        unsigned char const * const base = static_cast<unsigned char const *>( data );
+
+        mapped_variant_header header;
+
+        if ( base == nullptr
+            || size < sizeof( header )
+            || reinterpret_cast<std::uintptr_t>( base ) % layout::alignment != 0 )
+        {
+            return;
+        }
+
+        std::memcpy( &header, base, sizeof( header ) );
+
+        if ( std::memcmp( header.magic, "nsvarmap", sizeof( header.magic ) ) != 0
+            || header.version        != 1
+            || header.byte_order     != 0x01020304
+            || header.fingerprint    != variant_fingerprint< V >::value
+            || header.index_width    != 1
+            || header.alignment      != layout::alignment
+            || header.payload_stride != layout::payload_stride
+            || header.index_offset   != layout::index_offset
+            || header.count          >  ( size - layout::index_offset )
+            || header.payload_offset != layout::payload_offset( static_cast<std::size_t>( header.count ) )
+            || size < layout::size( static_cast<std::size_t>( header.count ) ) )
+        {
+            return;
+        }
+
+        count_   = static_cast<std::size_t>( header.count );
+        index_   = base + layout::index_offset;
+        payload_ = base + header.payload_offset;
+
+        for ( std::size_t i = 0; i != count_; ++i )
+        {
+            if ( index_[i] >= variant_size< V >::value )
+            {
+                *this = mapped_variant_span();
+                return;
+            }
+        }
+    }
+
+    bool valid() const noexcept
+    {
+        return index_ != nullptr;
+    }
+
+    std::size_t size() const noexcept
+    {
+        return count_;
+    }
+
+    bool empty() const noexcept
+    {
+        return count_ == 0;
+    }
+
+    // index of element i:
+
+    std::size_t index( std::size_t i ) const noexcept
+    {
+        return index_[i];
+    }
+
+    template< std::size_t K >
+    typename variant_alternative< K, V >::type const * get_if( std::size_t i ) const noexcept
+    {
+        typedef typename variant_alternative< K, V >::type type;
+
+        return index_[i] == K ? reinterpret_cast<type const *>( slot( i ) ) : nullptr;
+    }
+
+    template< class T >
+    T const * get_if( std::size_t i ) const noexcept
+    {
+        return get_if< variant_index_of< T, V >::value >( i );
+    }
+
+    // call f with the value of element i:
+
+    template< class F >
+    auto visit( std::size_t i, F && f ) const
+        -> decltype( f( std::declval< typename variant_alternative< 0, V >::type const & >() ) )
+    {
+        variants::detail::mapped_visit< V, F > const visit = { slot( i ), f };
+
+        return with_index< variant_size<V>::value >( index_[i], visit );
+    }
+
+    // copy of element i:
+
+    V operator[]( std::size_t i ) const
+    {
+        variants::detail::mapped_load< V > const load = { slot( i ) };
+
+        return with_index< variant_size<V>::value >( index_[i], load );
+    }
+
+private:
+    unsigned char const * slot( std::size_t i ) const noexcept
+    {
+        return payload_ + i * layout::payload_stride;
+    }
+
+private:
+    unsigned char const * index_;
+    unsigned char const * payload_;
+    std::size_t count_;
+};
+
+} // namespace nonstd
+
+#endif // variant_CPP11_OR_GREATER
+
+#endif // NONSTD_VARIANT_MAPPED_HPP
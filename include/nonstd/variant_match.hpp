@@ -0,0 +1,284 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Pattern matching on a variant with an overload set (C++11 and later).
+//
+// match( v, f1, f2, ... ) calls the handler fK that accepts the active
+// alternative of v, with the constness and value category of v, via one
+// switch on v.index() with direct calls that the optimizer can inline.
+// Every alternative must have a handler: an alternative without one is a
+// compile-time error that names its type. overload( f1, f2, ... ) combines
+// function objects and function pointers into one overload set.
+//
+// match_likely<T>( v, f1, f2, ... ) and visit_likely<T>( f, v ) first test
+// for alternative T with a branch hint, for streams where one alternative
+// is far more frequent than the others.
+
+#pragma once
+
+#ifndef NONSTD_VARIANT_MATCH_HPP
+#define NONSTD_VARIANT_MATCH_HPP
+
+#include "variant_util.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+#include <cassert>
+
+// branch prediction hint; variant.hpp does not define it if it selects std::variant:
+
+#ifndef variant_likely
+# if defined( __GNUC__ )
+#  define variant_likely( expr )  __builtin_expect( !!( expr ), 1 )
+# else
+#  define variant_likely( expr )  ( expr )
+# endif
+#endif
+
+namespace nonstd {
+namespace variants {
+namespace detail {
+
+// function pointer as a class to derive an overload set from:
+
+template< class R, class... A >
+struct function_handler
+{
+    R ( * fp )( A... );
+
+    constexpr function_handler( R ( * fp_ )( A... ) )
+        : fp( fp_ ) {}
+
+    constexpr R operator()( A... args ) const
+    {
+        return fp( std::forward<A>( args )... );
+    }
+};
+
+template< class F >
+struct handler_class
+{
+    typedef F type;
+};
+
+template< class R, class... A >
+struct handler_class< R ( * )( A... ) >
+{
+    typedef function_handler< R, A... > type;
+};
+
+template< class F >
+struct handler_type : handler_class< typename std::decay< F >::type > {};
+
+template< class T >
+struct match_void
+{
+    typedef void type;
+};
+
+template< class F, class A, class = void >
+struct is_handled : std::false_type {};
+
+template< class F, class A >
+struct is_handled< F, A, typename match_void< decltype( std::declval<F &>()( std::declval<A>() ) ) >::type > : std::true_type {};
+
+template< class F, class A >
+struct handler_result
+{
+    typedef decltype( std::declval<F &>()( std::declval<A>() ) ) type;
+};
+
+// Fails to compile for an alternative without handler; the compiler reports
+// the instantiation match_alternative_is_handled< Alternative, false > with
+// the type of each such alternative:
+
+template< class Alternative, bool Handled >
+struct match_alternative_is_handled
+{
+    static_assert( Handled, "match(): no handler accepts the alternative given as first template argument of match_alternative_is_handled<>." );
+
+    static constexpr bool value = Handled;
+};
+
+template< bool... B >
+struct all_of : std::is_same< all_of< true, B... >, all_of< B..., true > > {};
+
+template< class F, class V, class L >
+struct match_exhaustive;
+
+template< class F, class V, std::size_t... K >
+struct match_exhaustive< F, V, index_list< K... > >
+    : all_of< match_alternative_is_handled<
+        typename std::remove_reference< decltype( get<K>( std::declval<V>() ) ) >::type
+        , is_handled< F, decltype( get<K>( std::declval<V>() ) ) >::value >::value... > {};
+
+// result of the handler for the first alternative that has one:
+
+template< class F, class V, std::size_t K = 0, bool End = ( K == variant_size< typename std::decay< V >::type >::value ) >
+struct match_result
+    : std::conditional< is_handled< F, decltype( get<K>( std::declval<V>() ) ) >::value
+        , handler_result< F, decltype( get<K>( std::declval<V>() ) ) >
+        , match_result< F, V, K + 1 > >::type {};
+
+template< class F, class V, std::size_t K >
+struct match_result< F, V, K, true >
+{
+    typedef void type;
+};
+
+// calls the handler for alternative K:
+
+template< class F, class V >
+struct match_call
+{
+    F & f;
+    V & v;
+
+    template< std::size_t K >
+    constexpr auto operator()( std::integral_constant< std::size_t, K > ) const
+        -> decltype( f( get<K>( std::forward<V>( v ) ) ) )
+    {
+        return f( get<K>( std::forward<V>( v ) ) );
+    }
+};
+
+// dispatch on the index of the variant; not defined without a handler for every
+// alternative, as the static_assert in match() already reports that:
+
+template< bool Exhaustive >
+struct match_dispatch
+{
+    template< class R, class F, class V >
+    static variant_constexpr14 R apply( F & f, V && v )
+    {
+#if variant_CONFIG_NO_EXCEPTIONS
+        assert( ! v.valueless_by_exception() );
+#else
+        if ( v.valueless_by_exception() )
+        {
+            throw bad_variant_access();
+        }
+#endif
+        return with_index< variant_size< typename std::decay< V >::type >::value >( v.index(), match_call< F, V >{ f, v } );
+    }
+
+    template< class R, std::size_t Likely, class F, class V >
+    static variant_constexpr14 R apply_likely( F & f, V && v )
+    {
+        if ( variant_likely( v.index() == Likely ) )
+        {
+            return f( get< Likely >( std::forward<V>( v ) ) );
+        }
+        return apply< R >( f, std::forward<V>( v ) );
+    }
+};
+
+template<>
+struct match_dispatch< false >
+{
+    template< class R, class F, class V >
+    static R apply( F &, V && );
+
+    template< class R, std::size_t Likely, class F, class V >
+    static R apply_likely( F &, V && );
+};
+
+} // namespace detail
+} // namespace variants
+
+// non-standard: overload set of the given function objects and function pointers:
+
+template< class... Fs >
+struct overloaded;
+
+template< class F >
+struct overloaded< F > : F
+{
+    using F::operator();
+
+    constexpr explicit overloaded( F f )
+        : F( std::move( f ) ) {}
+};
+
+template< class F, class... Fs >
+struct overloaded< F, Fs... > : F, overloaded< Fs... >
+{
+    using F::operator();
+    using overloaded< Fs... >::operator();
+
+    constexpr explicit overloaded( F f, Fs... fs )
+        : F( std::move( f ) )
+        , overloaded< Fs... >( std::move( fs )... ) {}
+};
+
+template< class... Fs >
+inline constexpr overloaded< typename variants::detail::handler_type< Fs >::type... > overload( Fs &&... fs )
+{
+    return overloaded< typename variants::detail::handler_type< Fs >::type... >( std::forward<Fs>( fs )... );
+}
+
+// non-standard: call the handler among fs that accepts the active alternative of v,
+// with the result type of the handler for the first alternative; throws
+// bad_variant_access if v is valueless:
+
+template< class V, class... Fs >
+inline variant_constexpr14 typename variants::detail::match_result< overloaded< typename variants::detail::handler_type< Fs >::type... >, V && >::type
+match( V && v, Fs &&... fs )
+{
+    typedef overloaded< typename variants::detail::handler_type< Fs >::type... > handlers_type;
+    typedef typename variants::detail::match_result< handlers_type, V && >::type result_type;
+    typedef variants::detail::match_exhaustive< handlers_type, V &&
+        , typename variants::detail::make_index_list< variant_size< typename std::decay< V >::type >::value >::type > exhaustive;
+
+    static_assert( exhaustive::value, "match() requires a handler for every alternative." );
+
+    handlers_type handlers( std::forward<Fs>( fs )... );
+
+    return variants::detail::match_dispatch< exhaustive::value >::template apply< result_type >( handlers, std::forward<V>( v ) );
+}
+
+// non-standard: match( v, fs... ), testing for alternative T first, with a branch hint:
+
+template< class T, class V, class... Fs >
+inline variant_constexpr14 typename variants::detail::match_result< overloaded< typename variants::detail::handler_type< Fs >::type... >, V && >::type
+match_likely( V && v, Fs &&... fs )
+{
+    typedef overloaded< typename variants::detail::handler_type< Fs >::type... > handlers_type;
+    typedef typename variants::detail::match_result< handlers_type, V && >::type result_type;
+    typedef variants::detail::match_exhaustive< handlers_type, V &&
+        , typename variants::detail::make_index_list< variant_size< typename std::decay< V >::type >::value >::type > exhaustive;
+    typedef variants::detail::alternatives_contain< T, typename std::decay< V >::type > is_alternative;
+
+    // index 0 for a T that is not an alternative, so that only the static_assert below reports it:
+
+    typedef typename std::conditional< is_alternative::value
+        , variant_index_of< T, typename std::decay< V >::type >
+        , std::integral_constant< std::size_t, 0 > >::type likely_index;
+
+    static_assert( exhaustive::value, "match_likely() requires a handler for every alternative." );
+    static_assert( is_alternative::value, "match_likely<T>() requires T to be an alternative of the variant." );
+
+    handlers_type handlers( std::forward<Fs>( fs )... );
+
+    return variants::detail::match_dispatch< exhaustive::value >::template apply_likely< result_type
+        , likely_index::value >( handlers, std::forward<V>( v ) );
+}
+
+// non-standard: call f with the active alternative of v, testing for alternative T first, with a branch hint:
+
+template< class T, class F, class V >
+inline variant_constexpr14 auto visit_likely( F && f, V && v )
+    -> decltype( match_likely< T >( std::forward<V>( v ), std::forward<F>( f ) ) )
+{
+    return match_likely< T >( std::forward<V>( v ), std::forward<F>( f ) );
+}
+
+} // namespace nonstd
+
+#endif // variant_CPP11_OR_GREATER
+
+#endif // NONSTD_VARIANT_MATCH_HPP
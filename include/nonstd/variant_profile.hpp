@@ -0,0 +1,197 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Statistics of the operations on variants per alternative (C++11 and later).
+//
+// With variant_CONFIG_PROFILE defined to 1, nonstd::variant counts the
+// constructions, copies, moves, emplaces, visits and bad_variant_access
+// throws per variant type and per alternative in counters per thread.
+// variant_stats<V>() sums the counters of all threads for variant type V,
+// variant_stats_all() does so for every variant type counted so far, and
+// write_variant_stats_csv() and write_variant_stats_json() write them.
+// Without profiling, and with std::variant, the statistics are empty.
+
+#pragma once
+
+#ifndef NONSTD_VARIANT_PROFILE_HPP
+#define NONSTD_VARIANT_PROFILE_HPP
+
+#include "variant_util.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+#include <ostream>
+#include <vector>
+
+namespace nonstd {
+
+// non-standard: counts of the operations on one alternative:
+
+struct variant_alternative_stats
+{
+    unsigned long long constructions;
+    unsigned long long copies;
+    unsigned long long moves;
+    unsigned long long emplaces;
+    unsigned long long visits;
+    unsigned long long bad_accesses;
+};
+
+// non-standard: counts of the operations on a variant type, per alternative:
+
+struct variant_statistics
+{
+    bool enabled;
+    char const * name;
+    std::vector< variant_alternative_stats > alternatives;
+
+    variant_alternative_stats total() const
+    {
+        variant_alternative_stats sum = {};
+
+        for ( variant_alternative_stats const & a : alternatives )
+        {
+            sum.constructions += a.constructions;
+            sum.copies        += a.copies;
+            sum.moves         += a.moves;
+            sum.emplaces      += a.emplaces;
+            sum.visits        += a.visits;
+            sum.bad_accesses  += a.bad_accesses;
+        }
+        return sum;
+    }
+};
+
+namespace variants {
+namespace detail {
+
+#if variant_USES_PROFILE
+
+inline variant_statistics make_statistics( char const * name, std::size_t size, void ( * merge )( profile_counts & ) )
+{
+    profile_counts counts = {};
+    merge( counts );
+
+    variant_statistics stats = { true, name, std::vector< variant_alternative_stats >( size ) };
+
+    for ( std::size_t k = 0; k != size; ++k )
+    {
+        variant_alternative_stats const a = {
+            counts[ profile_construct  ][k],
+            counts[ profile_copy       ][k],
+            counts[ profile_move       ][k],
+            counts[ profile_emplace    ][k],
+            counts[ profile_visit      ][k],
+            counts[ profile_bad_access ][k] };
+
+        stats.alternatives[k] = a;
+    }
+    return stats;
+}
+
+#endif // variant_USES_PROFILE
+
+inline void write_json_string( std::ostream & os, char const * text )
+{
+    os << '"';
+
+    for ( ; *text; ++text )
+    {
+        if ( *text == '"' || *text == '\\' )
+        {
+            os << '\\';
+        }
+        os << *text;
+    }
+    os << '"';
+}
+
+} // namespace detail
+} // namespace variants
+
+// non-standard: statistics of variant type V, summed over all threads:
+
+template< class V >
+inline variant_statistics variant_stats()
+{
+#if variant_USES_PROFILE
+    typedef variants::detail::profile< V > profile;
+
+    return variants::detail::make_statistics( profile::name(), variant_size< V >::value, &profile::merge );
+#else
+    variant_statistics stats = { false, "", std::vector< variant_alternative_stats >( variant_size< V >::value ) };
+    return stats;
+#endif
+}
+
+// non-standard: statistics of all variant types counted so far:
+
+inline std::vector< variant_statistics > variant_stats_all()
+{
+    std::vector< variant_statistics > result;
+
+#if variant_USES_PROFILE
+    variants::detail::profile_type_list & list = variants::detail::profile_type_list::instance();
+    std::lock_guard< std::mutex > lock( list.mutex );
+
+    for ( variants::detail::profile_type const * type = list.head; type; type = type->next )
+    {
+        result.push_back( variants::detail::make_statistics( type->name, type->size, type->merge ) );
+    }
+#endif
+    return result;
+}
+
+// non-standard: write statistics as CSV, a line per alternative:
+
+inline std::ostream & write_variant_stats_csv( std::ostream & os, std::vector< variant_statistics > const & stats )
+{
+    os << "variant,index,constructions,copies,moves,emplaces,visits,bad_accesses\n";
+
+    for ( variant_statistics const & s : stats )
+    {
+        for ( std::size_t k = 0; k != s.alternatives.size(); ++k )
+        {
+            variant_alternative_stats const & a = s.alternatives[k];
+
+            os << '"' << s.name << "\"," << k << ',' << a.constructions << ',' << a.copies << ',' << a.moves
+               << ',' << a.emplaces << ',' << a.visits << ',' << a.bad_accesses << '\n';
+        }
+    }
+    return os;
+}
+
+// non-standard: write statistics as JSON, an array of variants with an array of alternatives each:
+
+inline std::ostream & write_variant_stats_json( std::ostream & os, std::vector< variant_statistics > const & stats )
+{
+    os << '[';
+
+    for ( std::size_t v = 0; v != stats.size(); ++v )
+    {
+        os << ( v ? ",\n " : "\n " ) << "{\"variant\":";
+        variants::detail::write_json_string( os, stats[v].name );
+        os << ",\"alternatives\":[";
+
+        for ( std::size_t k = 0; k != stats[v].alternatives.size(); ++k )
+        {
+            variant_alternative_stats const & a = stats[v].alternatives[k];
+
+            os << ( k ? "," : "" ) << "{\"index\":" << k << ",\"constructions\":" << a.constructions
+               << ",\"copies\":" << a.copies << ",\"moves\":" << a.moves << ",\"emplaces\":" << a.emplaces
+               << ",\"visits\":" << a.visits << ",\"bad_accesses\":" << a.bad_accesses << '}';
+        }
+        os << "]}";
+    }
+    return os << ( stats.empty() ? "]\n" : "\n]\n" );
+}
+
+} // namespace nonstd
+
+#endif // variant_CPP11_OR_GREATER
+
+#endif // NONSTD_VARIANT_PROFILE_HPP
@@ -0,0 +1,435 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Bounded ring buffers of variants (C++11 and later).
+//
+// variant_ring<V, Capacity, ring_spsc> is a single-producer, single-consumer
+// ring; variant_ring<V, Capacity, ring_mpmc> is a multi-producer, multi-consumer
+// ring after Dmitry Vyukov's bounded queue. Producers construct the variant
+// directly in its slot via try_emplace<K>(), consumers visit the alternative
+// in place via try_consume() and consume_batch(), after which the variant is
+// destroyed. Thus a message is constructed and destroyed once, and never moved.
+// Producer and consumer positions are on separate cache lines.
+
+#pragma once
+
+#ifndef NONSTD_VARIANT_RING_HPP
+#define NONSTD_VARIANT_RING_HPP
+
+#include "variant_util.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <new>
+
+namespace nonstd {
+
+// non-standard: concurrency of variant_ring:
+
+struct ring_spsc {};
+struct ring_mpmc {};
+
+// non-standard: assumed size of a cache line:
+
+#ifndef variant_CONFIG_CACHE_LINE_SIZE
+# define variant_CONFIG_CACHE_LINE_SIZE  64
+#endif
+
+namespace variants {
+namespace detail {
+
+// raw storage for one variant:
+
+template< class V >
+struct ring_storage
+{
+    V * get() noexcept
+    {
+        return reinterpret_cast<V *>( bytes );
+    }
+
+    alignas( V ) unsigned char bytes[ sizeof( V ) ];
+};
+
+// call f with the alternative of v in place:
+
+template< class V, class F >
+struct ring_visit
+{
+    V & v;
+    F & f;
+
+    template< std::size_t K >
+    void operator()( std::integral_constant< std::size_t, K > ) const
+    {
+        f( *nonstd::get_if<K>( &v ) );
+    }
+};
+
+// visit the variant, then destroy it, also if the visitor throws:
+
+template< class V, class F >
+inline void ring_consume( V * v, F & f )
+{
+    struct destroy
+    {
+        V * v;
+        ~destroy() { v->~V(); }
+    } const guard = { v };
+
+    if ( ! v->valueless_by_exception() )
+    {
+        ring_visit< V, F > const visit = { *v, f };
+
+        with_index< variant_size<V>::value >( v->index(), visit );
+    }
+}
+
+} // namespace detail
+} // namespace variants
+
+template< class V, std::size_t Capacity, class Concurrency = ring_spsc >
+class variant_ring;
+
+// single producer, single consumer:
+
+template< class V, std::size_t Capacity >
+class variant_ring< V, Capacity, ring_spsc >
+{
+    static_assert( Capacity > 0 && ( Capacity & ( Capacity - 1 ) ) == 0, "variant_ring capacity must be a power of two." );
+
+    static constexpr std::size_t mask = Capacity - 1;
+
+public:
+    typedef V value_type;
+
+    variant_ring() noexcept
+        : tail_( 0 ), head_cache_( 0 ), head_( 0 ), tail_cache_( 0 ) {}
+
+    variant_ring( variant_ring const & ) = delete;
+    variant_ring & operator=( variant_ring const & ) = delete;
+
+    ~variant_ring()
+    {
+        for ( std::size_t pos = head_.load( std::memory_order_relaxed ); pos != tail_.load( std::memory_order_relaxed ); ++pos )
+        {
+            slots_[ pos & mask ].get()->~V();
+        }
+    }
+
+    static constexpr std::size_t capacity() noexcept
+    {
+        return Capacity;
+    }
+
+    // approximate if called concurrently with producer or consumer:
+
+    std::size_t size() const noexcept
+    {
+        return tail_.load( std::memory_order_acquire ) - head_.load( std::memory_order_acquire );
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    // producer: construct alternative K in the next slot; return false if full:
+
+    template< std::size_t K, class... Args >
+    bool try_emplace( Args &&... args )
+    {
+        std::size_t const tail = tail_.load( std::memory_order_relaxed );
+
+        if ( tail - head_cache_ == Capacity )
+        {
+            head_cache_ = head_.load( std::memory_order_acquire );
+
+            if ( tail - head_cache_ == Capacity )
+            {
+                return false;
+            }
+        }
+
+        ::new( static_cast<void *>( slots_[ tail & mask ].get() ) ) V( nonstd_lite_in_place_index(K), std::forward<Args>( args )... );
+
+        tail_.store( tail + 1, std::memory_order_release );
+        return true;
+    }
+
+    template< class T, class... Args >
+    bool try_emplace( Args &&... args )
+    {
+        return try_emplace< variant_index_of< T, V >::value >( std::forward<Args>( args )... );
+    }
+
+    // consumer: call f with the alternative of the oldest variant, then destroy
+    // it; return false if empty:
+
+    template< class F >
+    bool try_consume( F && f )
+    {
+        std::size_t const head = head_.load( std::memory_order_relaxed );
+
+        if ( head == tail_cache_ )
+        {
+            tail_cache_ = tail_.load( std::memory_order_acquire );
+
+            if ( head == tail_cache_ )
+            {
+                return false;
+            }
+        }
+
+        release_guard const release = { head_, head + 1 };
+
+        variants::detail::ring_consume( slots_[ head & mask ].get(), f );
+        return true;
+    }
+
+    // consumer: as try_consume() for up to max variants present, releasing
+    // their slots at once; return the number of variants consumed:
+
+    template< class F >
+    std::size_t consume_batch( F && f, std::size_t max = Capacity )
+    {
+        std::size_t const head = head_.load( std::memory_order_relaxed );
+
+        tail_cache_ = tail_.load( std::memory_order_acquire );
+
+        std::size_t const count = ( std::min )( tail_cache_ - head, max );
+
+        release_guard release = { head_, head };
+
+        for ( std::size_t i = 0; i != count; ++i )
+        {
+            variants::detail::ring_consume( slots_[ ( head + i ) & mask ].get(), f );
+            ++release.position;
+        }
+        return count;
+    }
+
+private:
+    struct release_guard
+    {
+        std::atomic< std::size_t > & head;
+        std::size_t position;
+
+        ~release_guard()
+        {
+            head.store( position, std::memory_order_release );
+        }
+    };
+
+private:
+    variants::detail::ring_storage< V > slots_[ Capacity ];
+
+    alignas( variant_CONFIG_CACHE_LINE_SIZE ) std::atomic< std::size_t > tail_;
+    std::size_t head_cache_;
+
+    alignas( variant_CONFIG_CACHE_LINE_SIZE ) std::atomic< std::size_t > head_;
+    std::size_t tail_cache_;
+};
+
+// multiple producers, multiple consumers:
+
+template< class V, std::size_t Capacity >
+class variant_ring< V, Capacity, ring_mpmc >
+{
+    static_assert( Capacity > 1 && ( Capacity & ( Capacity - 1 ) ) == 0, "variant_ring capacity must be a power of two, greater than one." );
+
+    static constexpr std::size_t mask = Capacity - 1;
+
+    // a slot is free for the producer at position p if sequence == p,
+    // and holds a variant for the consumer at position p if sequence == p + 1:
+
+    struct cell
+    {
+        std::atomic< std::size_t > sequence;
+        bool constructed;
+        variants::detail::ring_storage< V > storage;
+    };
+
+public:
+    typedef V value_type;
+
+    variant_ring() noexcept
+        : enqueue_( 0 ), dequeue_( 0 )
+    {
+        for ( std::size_t i = 0; i != Capacity; ++i )
+        {
+            cells_[i].sequence.store( i, std::memory_order_relaxed );
+        }
+    }
+
+    variant_ring( variant_ring const & ) = delete;
+    variant_ring & operator=( variant_ring const & ) = delete;
+
+    ~variant_ring()
+    {
+        for ( std::size_t pos = dequeue_.load( std::memory_order_relaxed ); pos != enqueue_.load( std::memory_order_relaxed ); ++pos )
+        {
+            if ( cells_[ pos & mask ].constructed )
+            {
+                cells_[ pos & mask ].storage.get()->~V();
+            }
+        }
+    }
+
+    static constexpr std::size_t capacity() noexcept
+    {
+        return Capacity;
+    }
+
+    // approximate if called concurrently with producers or consumers:
+
+    std::size_t size() const noexcept
+    {
+        std::size_t const dequeue = dequeue_.load( std::memory_order_acquire );
+        std::size_t const enqueue = enqueue_.load( std::memory_order_acquire );
+
+        return enqueue > dequeue ? enqueue - dequeue : 0;
+    }
+
+    bool empty() const noexcept
+    {
+        return size() == 0;
+    }
+
+    // producer: construct alternative K in the next slot; return false if full.
+    // If construction throws, the slot is skipped by the consumers:
+
+    template< std::size_t K, class... Args >
+    bool try_emplace( Args &&... args )
+    {
+        std::size_t pos = enqueue_.load( std::memory_order_relaxed );
+        cell * c = nullptr;
+
+        for ( ;; )
+        {
+            c = &cells_[ pos & mask ];
+
+            std::intptr_t const diff = static_cast<std::intptr_t>( c->sequence.load( std::memory_order_acquire ) ) - static_cast<std::intptr_t>( pos );
+
+            if ( diff == 0 )
+            {
+                if ( enqueue_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                {
+                    break;
+                }
+            }
+            else if ( diff < 0 )
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueue_.load( std::memory_order_relaxed );
+            }
+        }
+
+        publish_guard const publish = { *c, pos + 1 };
+
+        c->constructed = false;
+        ::new( static_cast<void *>( c->storage.get() ) ) V( nonstd_lite_in_place_index(K), std::forward<Args>( args )... );
+        c->constructed = true;
+
+        return true;
+    }
+
+    template< class T, class... Args >
+    bool try_emplace( Args &&... args )
+    {
+        return try_emplace< variant_index_of< T, V >::value >( std::forward<Args>( args )... );
+    }
+
+    // consumer: call f with the alternative of the oldest variant, then destroy
+    // it; return false if empty:
+
+    template< class F >
+    bool try_consume( F && f )
+    {
+        for ( ;; )
+        {
+            std::size_t pos = dequeue_.load( std::memory_order_relaxed );
+            cell * c = nullptr;
+
+            for ( ;; )
+            {
+                c = &cells_[ pos & mask ];
+
+                std::intptr_t const diff = static_cast<std::intptr_t>( c->sequence.load( std::memory_order_acquire ) ) - static_cast<std::intptr_t>( pos + 1 );
+
+                if ( diff == 0 )
+                {
+                    if ( dequeue_.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) )
+                    {
+                        break;
+                    }
+                }
+                else if ( diff < 0 )
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = dequeue_.load( std::memory_order_relaxed );
+                }
+            }
+
+            publish_guard const publish = { *c, pos + Capacity };
+
+            if ( c->constructed )
+            {
+                variants::detail::ring_consume( c->storage.get(), f );
+                return true;
+            }
+        }
+    }
+
+    // consumer: as try_consume() for up to max variants; return the number of
+    // variants consumed:
+
+    template< class F >
+    std::size_t consume_batch( F && f, std::size_t max = Capacity )
+    {
+        std::size_t count = 0;
+
+        while ( count != max && try_consume( f ) )
+        {
+            ++count;
+        }
+        return count;
+    }
+
+private:
+    struct publish_guard
+    {
+        cell & c;
+        std::size_t sequence;
+
+        ~publish_guard()
+        {
+            c.sequence.store( sequence, std::memory_order_release );
+        }
+    };
+
+private:
+    cell cells_[ Capacity ];
+
+    alignas( variant_CONFIG_CACHE_LINE_SIZE ) std::atomic< std::size_t > enqueue_;
+    alignas( variant_CONFIG_CACHE_LINE_SIZE ) std::atomic< std::size_t > dequeue_;
+};
+
+} // namespace nonstd
+
+#endif // variant_CPP11_OR_GREATER
+
+#endif // NONSTD_VARIANT_RING_HPP
@@ -0,0 +1,211 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Sequence-lock protected variant for read-mostly variants with trivially
+// copyable alternatives of any size (C++11 and later).
+//
+// seqlock_variant<V> keeps the packed variant (see variant_atomic.hpp) in an
+// array of atomic words, guarded by a sequence counter that is odd while the
+// single writer updates the words. Readers copy the words optimistically and
+// retry if the counter changed meanwhile; they never block the writer and the
+// writer never waits for readers. Readers only see the copy once validated.
+
+#pragma once
+
+#ifndef NONSTD_VARIANT_SEQLOCK_HPP
+#define NONSTD_VARIANT_SEQLOCK_HPP
+
+#include "variant_atomic.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+namespace nonstd {
+
+// non-standard: sequence-lock protected variant, see above; store() and emplace()
+// must be called from one writer thread at a time, the readers from any thread:
+
+template< class V >
+class seqlock_variant
+{
+    static_assert( variant_is_trivially_copyable< V >::value, "seqlock_variant requires trivially copyable alternatives." );
+    static_assert( variant_size< V >::value <= 255, "seqlock_variant supports at most 255 alternatives." );
+
+    static constexpr std::size_t word_count = ( 1 + variant_max_sizeof< V >::value + sizeof( std::uint64_t ) - 1 ) / sizeof( std::uint64_t );
+
+    struct words_type
+    {
+        std::uint64_t words[ word_count ];
+    };
+
+    typedef variants::detail::packed_variant< V, words_type > packed;
+
+public:
+    typedef V value_type;
+
+    seqlock_variant() noexcept
+        : sequence_( 0 )
+    {
+        initialize( packed::pack( V() ) );
+    }
+
+    explicit seqlock_variant( V const & v ) noexcept
+        : sequence_( 0 )
+    {
+        initialize( packed::pack( v ) );
+    }
+
+    seqlock_variant( seqlock_variant const & ) = delete;
+    seqlock_variant & operator=( seqlock_variant const & ) = delete;
+
+    // writer:
+
+    seqlock_variant & operator=( V const & v ) noexcept
+    {
+        store( v );
+        return *this;
+    }
+
+    void store( V const & v ) noexcept
+    {
+        write( packed::pack( v ) );
+    }
+
+    template< std::size_t K, class... Args >
+    void emplace( Args &&... args )
+    {
+        store( V( nonstd_lite_in_place_index(K), std::forward<Args>( args )... ) );
+    }
+
+    template< class T, class... Args >
+    void emplace( Args &&... args )
+    {
+        emplace< variant_index_of< T, V >::value >( std::forward<Args>( args )... );
+    }
+
+    // readers:
+
+    V load() const noexcept
+    {
+        return packed::unpack( read() );
+    }
+
+    // copy the value to v and return true, or return false if a write was in progress:
+
+    bool try_load( V & v ) const noexcept
+    {
+        words_type words;
+
+        if ( ! try_read( words ) )
+        {
+            return false;
+        }
+        v = packed::unpack( words );
+        return true;
+    }
+
+    std::size_t index() const noexcept
+    {
+        return packed::index( read() );
+    }
+
+    // call f with a consistent copy of the current value:
+
+    template< class F >
+    auto visit( F && f ) const
+        -> decltype( f( std::declval< typename variant_alternative< 0, V >::type const & >() ) )
+    {
+        return packed::visit( read(), f );
+    }
+
+    // call f with a consistent copy of the current value and return true,
+    // or return false without calling f if a write was in progress:
+
+    template< class F >
+    bool try_visit( F && f ) const
+    {
+        words_type words;
+
+        if ( ! try_read( words ) )
+        {
+            return false;
+        }
+        packed::visit( words, f );
+        return true;
+    }
+
+    // number of stores since construction:
+
+    std::uint64_t version() const noexcept
+    {
+        return sequence_.load( std::memory_order_acquire ) / 2;
+    }
+
+private:
+    // no reader can observe the variant before construction completes, hence
+    // the initial value is not counted as a store:
+
+    void initialize( words_type const & words ) noexcept
+    {
+        for ( std::size_t i = 0; i != word_count; ++i )
+        {
+            data_[i].store( words.words[i], std::memory_order_relaxed );
+        }
+    }
+
+    void write( words_type const & words ) noexcept
+    {
+        std::uint64_t const sequence = sequence_.load( std::memory_order_relaxed );
+
+        sequence_.store( sequence + 1, std::memory_order_relaxed );
+        std::atomic_thread_fence( std::memory_order_release );
+
+        for ( std::size_t i = 0; i != word_count; ++i )
+        {
+            data_[i].store( words.words[i], std::memory_order_relaxed );
+        }
+
+        sequence_.store( sequence + 2, std::memory_order_release );
+    }
+
+    bool try_read( words_type & words ) const noexcept
+    {
+        std::uint64_t const sequence = sequence_.load( std::memory_order_acquire );
+
+        if ( sequence & 1 )
+        {
+            return false;
+        }
+
+        for ( std::size_t i = 0; i != word_count; ++i )
+        {
+            words.words[i] = data_[i].load( std::memory_order_relaxed );
+        }
+
+        std::atomic_thread_fence( std::memory_order_acquire );
+
+        return sequence_.load( std::memory_order_relaxed ) == sequence;
+    }
+
+    words_type read() const noexcept
+    {
+        words_type words;
+
+        while ( ! try_read( words ) ) {}
+
+        return words;
+    }
+
+private:
+    std::atomic< std::uint64_t > sequence_;
+    std::atomic< std::uint64_t > data_[ word_count ];
+};
+
+} // namespace nonstd
+
+#endif // variant_CPP11_OR_GREATER
+
+#endif // NONSTD_VARIANT_SEQLOCK_HPP
@@ -0,0 +1,785 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Binary serialization of variants (C++11 and later).
+//
+// Wire layout of a variant: the index as unsigned LEB128 varint, followed by
+// the payload of the contained alternative as written by variant_codec<T>.
+// Wire layout of a sequence: the number of elements as varint, followed by
+// the elements. Trivially copyable payloads are their object representation,
+// hence this layout is only portable between machines with the same ABI.
+
+#pragma once
+
+#ifndef NONSTD_VARIANT_SERIALIZE_HPP
+#define NONSTD_VARIANT_SERIALIZE_HPP
+
+#include "variant_util.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nonstd {
+namespace variants {
+namespace detail {
+
+// unsigned LEB128 varint:
+
+inline std::size_t varint_size( std::size_t value ) noexcept
+{
+    std::size_t size = 1;
+
+    for ( ; value >= 0x80; value >>= 7 )
+    {
+        ++size;
+    }
+    return size;
+}
+
+inline char * varint_encode( std::size_t value, char * out ) noexcept
+{
+    for ( ; value >= 0x80; value >>= 7 )
+    {
+        *out++ = static_cast<char>( ( value & 0x7f ) | 0x80 );
+    }
+    *out++ = static_cast<char>( value );
+
+    return out;
+}
+
+// true if the 7 bits of a varint byte at shift do not fit in a std::size_t:
+
+inline bool varint_overflows( unsigned char byte, unsigned shift ) noexcept
+{
+    unsigned const digits = unsigned( std::numeric_limits<std::size_t>::digits );
+
+    return shift + 7 > digits && ( ( byte & 0x7f ) >> ( digits - shift ) ) != 0;
+}
+
+// true if a varint byte at shift is a last byte without bits, as in a non-minimal
+// encoding such as 0x80 0x00 for 0:
+
+inline bool varint_overlong( unsigned char byte, unsigned shift ) noexcept
+{
+    return shift > 0 && byte == 0;
+}
+
+// return past the varint, or nullptr if the input is truncated, overlong or overflows:
+
+inline char const * varint_decode( char const * first, char const * last, std::size_t & value ) noexcept
+{
+    value = 0;
+
+    for ( unsigned shift = 0; first != last && shift < unsigned( std::numeric_limits<std::size_t>::digits ); shift += 7 )
+    {
+        unsigned char const byte = static_cast<unsigned char>( *first++ );
+
+        if ( varint_overflows( byte, shift ) || varint_overlong( byte, shift ) )
+        {
+            return nullptr;
+        }
+
+        value |= static_cast<std::size_t>( byte & 0x7f ) << shift;
+
+        if ( byte < 0x80 )
+        {
+            return first;
+        }
+    }
+    return nullptr;
+}
+
+// emplace alternative K into the variant, as handed to variant_codec<T>::decode():
+
+template< class V, std::size_t K >
+struct variant_emplacer
+{
+    V & v;
+
+    template< class... Args >
+    typename variant_alternative< K, V >::type & operator()( Args &&... args ) const
+    {
+        return v.template emplace<K>( std::forward<Args>( args )... );
+    }
+};
+
+// copy the object representation of a trivially copyable type into the variant:
+
+template< class T, class Emplace >
+inline void decode_trivial( char const * first, Emplace & emplace, std::true_type /*trivially default constructible*/ )
+{
+    std::memcpy( std::addressof( emplace() ), first, sizeof( T ) );
+}
+
+template< class T, class Emplace >
+inline void decode_trivial( char const * first, Emplace & emplace, std::false_type /*trivially default constructible*/ )
+{
+    alignas( T ) unsigned char buffer[ sizeof( T ) ];
+
+    std::memcpy( buffer, first, sizeof( T ) );
+
+    emplace( *reinterpret_cast<T const *>( buffer ) );
+}
+
+} // namespace detail
+} // namespace variants
+
+// non-standard: per-alternative codec; specialize for types that are not trivially copyable.
+//
+// A codec provides:
+// - static std::size_t size( T const & value ): number of bytes encode() writes,
+// - static char * encode( T const & value, char * out ): write value, return past it,
+// - template< class Emplace >
+//   static char const * decode( char const * first, char const * last, Emplace & emplace ):
+//   construct the value via emplace( args... ), which emplaces it directly into the
+//   variant and returns a reference to it; return past the input used, or nullptr
+//   if the input is malformed or truncated.
+//
+// For use with variant_decoder, a codec also provides:
+// - static bool framed_size( char const * first, char const * last, std::size_t & size ):
+//   set size to the number of bytes of the encoded value that starts at first and
+//   return true, or return false if [first, last) is too short to tell.
+// A codec may declare static constexpr bool object_representation = true if the
+// encoded value is the object representation of T, to let variant_decoder copy
+// partially received input directly into the variant.
+
+template< class T, class Enable = void >
+struct variant_codec;
+
+// empty types, such as monostate, have no payload:
+
+template< class T >
+struct variant_codec< T, typename std::enable_if< std::is_empty<T>::value >::type >
+{
+    static std::size_t size( T const & ) noexcept
+    {
+        return 0;
+    }
+
+    static char * encode( T const &, char * out ) noexcept
+    {
+        return out;
+    }
+
+    static bool framed_size( char const *, char const *, std::size_t & size ) noexcept
+    {
+        size = 0;
+        return true;
+    }
+
+    template< class Emplace >
+    static char const * decode( char const * first, char const *, Emplace & emplace )
+    {
+        emplace();
+        return first;
+    }
+};
+
+// trivially copyable types are written and read with a single memcpy:
+
+template< class T >
+struct variant_codec< T, typename std::enable_if< std::is_trivially_copyable<T>::value && ! std::is_empty<T>::value >::type >
+{
+    static constexpr bool object_representation = true;
+
+    static std::size_t size( T const & ) noexcept
+    {
+        return sizeof( T );
+    }
+
+    static bool framed_size( char const *, char const *, std::size_t & size ) noexcept
+    {
+        size = sizeof( T );
+        return true;
+    }
+
+    static char * encode( T const & value, char * out ) noexcept
+    {
+        std::memcpy( out, std::addressof( value ), sizeof( T ) );
+        return out + sizeof( T );
+    }
+
+    template< class Emplace >
+    static char const * decode( char const * first, char const * last, Emplace & emplace )
+    {
+        if ( static_cast<std::size_t>( last - first ) < sizeof( T ) )
+        {
+            return nullptr;
+        }
+
+        variants::detail::decode_trivial<T>( first, emplace, std::is_trivially_default_constructible<T>() );
+
+        return first + sizeof( T );
+    }
+};
+
+// strings are written as their length as varint, followed by their characters:
+
+template< class CharT, class Traits, class Allocator >
+struct variant_codec< std::basic_string< CharT, Traits, Allocator > >
+{
+    typedef std::basic_string< CharT, Traits, Allocator > string_type;
+
+    static std::size_t size( string_type const & value ) noexcept
+    {
+        return variants::detail::varint_size( value.size() ) + value.size() * sizeof( CharT );
+    }
+
+    static char * encode( string_type const & value, char * out ) noexcept
+    {
+        out = variants::detail::varint_encode( value.size(), out );
+
+        if ( ! value.empty() )
+        {
+            std::memcpy( out, value.data(), value.size() * sizeof( CharT ) );
+        }
+        return out + value.size() * sizeof( CharT );
+    }
+
+    // a malformed length prefix reports the prefix only, so that decode() rejects it:
+
+    static bool framed_size( char const * first, char const * last, std::size_t & size ) noexcept
+    {
+        std::size_t length = 0;
+        char const * const pos = variants::detail::varint_decode( first, last, length );
+
+        if ( pos == nullptr )
+        {
+            size = static_cast<std::size_t>( last - first );
+            return size >= variants::detail::varint_size( std::numeric_limits<std::size_t>::max() );
+        }
+
+        size = static_cast<std::size_t>( pos - first );
+
+        if ( length <= ( std::numeric_limits<std::size_t>::max() - size ) / sizeof( CharT ) )
+        {
+            size += length * sizeof( CharT );
+        }
+        return true;
+    }
+
+    template< class Emplace >
+    static char const * decode( char const * first, char const * last, Emplace & emplace )
+    {
+        std::size_t length = 0;
+
+        if ( nullptr == ( first = variants::detail::varint_decode( first, last, length ) )
+            || length > static_cast<std::size_t>( last - first ) / sizeof( CharT ) )
+        {
+            return nullptr;
+        }
+
+        return decode_chars( first, length, emplace, std::integral_constant< bool, sizeof( CharT ) == 1 >() );
+    }
+
+private:
+    template< class Emplace >
+    static char const * decode_chars( char const * first, std::size_t length, Emplace & emplace, std::true_type /*char-sized*/ )
+    {
+        emplace( reinterpret_cast<CharT const *>( first ), length );
+
+        return first + length;
+    }
+
+    template< class Emplace >
+    static char const * decode_chars( char const * first, std::size_t length, Emplace & emplace, std::false_type /*char-sized*/ )
+    {
+        string_type & value = emplace( length, CharT() );
+
+        if ( length > 0 )
+        {
+            std::memcpy( &value[0], first, length * sizeof( CharT ) );
+        }
+        return first + length * sizeof( CharT );
+    }
+};
+
+namespace variants {
+namespace detail {
+
+template< class V >
+struct payload_size
+{
+    V const & v;
+
+    template< std::size_t K >
+    std::size_t operator()( std::integral_constant< std::size_t, K > ) const
+    {
+        typedef typename variant_alternative< K, V >::type type;
+
+        return variant_codec< type >::size( *nonstd::get_if<K>( &v ) );
+    }
+};
+
+template< class V >
+struct payload_encode
+{
+    V const & v;
+    char * out;
+
+    template< std::size_t K >
+    char * operator()( std::integral_constant< std::size_t, K > ) const
+    {
+        typedef typename variant_alternative< K, V >::type type;
+
+        return variant_codec< type >::encode( *nonstd::get_if<K>( &v ), out );
+    }
+};
+
+template< class V >
+struct payload_decode
+{
+    V & v;
+    char const * first;
+    char const * last;
+
+    template< std::size_t K >
+    char const * operator()( std::integral_constant< std::size_t, K > ) const
+    {
+        typedef typename variant_alternative< K, V >::type type;
+
+        variant_emplacer< V, K > emplace = { v };
+
+        return variant_codec< type >::decode( first, last, emplace );
+    }
+};
+
+} // namespace detail
+} // namespace variants
+
+// non-standard: number of bytes serialize() writes for v; 0 for a valueless variant:
+
+template< class V >
+inline std::size_t serialized_size( V const & v )
+{
+    if ( v.valueless_by_exception() )
+    {
+        return 0;
+    }
+
+    variants::detail::payload_size< V > const size = { v };
+
+    return variants::detail::varint_size( v.index() ) + with_index< variant_size<V>::value >( v.index(), size );
+}
+
+// non-standard: write v to out, which must provide serialized_size( v ) bytes;
+// return past the bytes written, or nullptr for a valueless variant:
+
+template< class V >
+inline char * serialize( V const & v, char * out )
+{
+    if ( v.valueless_by_exception() )
+    {
+        return nullptr;
+    }
+
+    variants::detail::payload_encode< V > const encode = { v, variants::detail::varint_encode( v.index(), out ) };
+
+    return with_index< variant_size<V>::value >( v.index(), encode );
+}
+
+// non-standard: read a variant from [first, last) into v, constructing the
+// alternative in place; return past the bytes read, or nullptr if the input
+// is malformed or truncated:
+
+template< class V >
+inline char const * deserialize( char const * first, char const * last, V & v )
+{
+    std::size_t index = 0;
+
+    if ( nullptr == ( first = variants::detail::varint_decode( first, last, index ) )
+        || index >= variant_size<V>::value )
+    {
+        return nullptr;
+    }
+
+    variants::detail::payload_decode< V > const decode = { v, first, last };
+
+    return with_index< variant_size<V>::value >( index, decode );
+}
+
+// non-standard: sequences of variants:
+
+template< class InputIt >
+inline std::size_t serialized_range_size( InputIt first, InputIt last )
+{
+    std::size_t count = 0;
+    std::size_t size  = 0;
+
+    for ( ; first != last; ++first, ++count )
+    {
+        size += serialized_size( *first );
+    }
+    return variants::detail::varint_size( count ) + size;
+}
+
+// return past the bytes written, or nullptr if the sequence contains a valueless variant:
+
+template< class ForwardIt >
+inline char * serialize_range( ForwardIt first, ForwardIt last, char * out )
+{
+    out = variants::detail::varint_encode( static_cast<std::size_t>( std::distance( first, last ) ), out );
+
+    for ( ; first != last && out != nullptr; ++first )
+    {
+        out = serialize( *first, out );
+    }
+    return out;
+}
+
+// append the variants read to container, constructing each alternative in the
+// container's new element; return past the bytes read, or nullptr if the input
+// is malformed or truncated, in which case the variants read so far remain:
+
+template< class Container >
+inline char const * deserialize_range( char const * first, char const * last, Container & container )
+{
+    std::size_t count = 0;
+
+    if ( nullptr == ( first = variants::detail::varint_decode( first, last, count ) ) )
+    {
+        return nullptr;
+    }
+
+    for ( ; count > 0; --count )
+    {
+        container.emplace_back();
+
+        if ( nullptr == ( first = deserialize( first, last, container.back() ) ) )
+        {
+            container.pop_back();
+            return nullptr;
+        }
+    }
+    return first;
+}
+
+// non-standard: codec family used by variant_decoder, codec< T > is variant_codec< T >:
+
+struct variant_codecs
+{
+    template< class T >
+    using codec = variant_codec< T >;
+};
+
+namespace variants {
+namespace detail {
+
+template< class C, class = void >
+struct codec_is_object_representation : std::false_type {};
+
+template< class C >
+struct codec_is_object_representation< C, typename std::enable_if< C::object_representation >::type > : std::true_type {};
+
+} // namespace detail
+} // namespace variants
+
+// non-standard: resumable decoder for a stream of variants as written by serialize(),
+// that accepts input in fragments of any size and emits each variant once complete.
+//
+// Each variant is decoded into the decoder's own variant. The payload of a
+// trivially copyable alternative is copied into that variant's storage as it
+// arrives; other payloads are decoded directly from the input if a fragment
+// holds them completely, or else gathered until complete. Malformed input, and
+// a payload larger than max_payload(), put the decoder in the failed state, in
+// which it ignores input until reset().
+
+template< class V, class Codecs = variant_codecs >
+class variant_decoder
+{
+    enum state_type { expect_index, expect_payload, complete, malformed };
+
+    static constexpr std::size_t unknown = static_cast<std::size_t>( -1 );
+
+public:
+    typedef V value_type;
+
+    // default limit of the size of a payload that is not copied as it arrives:
+
+    static constexpr std::size_t default_max_payload = std::size_t( 16 ) * 1024 * 1024;
+
+    explicit variant_decoder( std::size_t max_payload = default_max_payload )
+        : max_payload_( max_payload )
+        , value_()
+        , index_( 0 )
+        , shift_( 0 )
+        , filled_( 0 )
+        , size_( unknown )
+        , state_( expect_index )
+        , pending_()
+    {}
+
+    bool failed() const noexcept
+    {
+        return state_ == malformed;
+    }
+
+    std::size_t max_payload() const noexcept
+    {
+        return max_payload_;
+    }
+
+    // true if no partially received variant is pending:
+
+    bool idle() const noexcept
+    {
+        return state_ == expect_index && shift_ == 0;
+    }
+
+    void reset() noexcept
+    {
+        index_  = 0;
+        shift_  = 0;
+        filled_ = 0;
+        size_   = unknown;
+        state_  = expect_index;
+        pending_.clear();
+    }
+
+    // call on_variant( V & ) for each variant completed by [first, last);
+    // return the number of variants completed:
+
+    template< class F >
+    std::size_t decode( char const * first, char const * last, F && on_variant )
+    {
+        std::size_t count = 0;
+
+        while ( first != last && state_ != malformed )
+        {
+            first = state_ == expect_index ? read_index( first, last ) : read_payload( first, last );
+
+            if ( state_ == complete )
+            {
+                ++count;
+                state_ = expect_index;
+                on_variant( value_ );
+            }
+        }
+        return count;
+    }
+
+    // move each variant completed by [first, last) to out; return out past them:
+
+    template< class OutputIt >
+    OutputIt decode_many( char const * first, char const * last, OutputIt out )
+    {
+        decode( first, last, [&out]( V & v ) { *out++ = std::move( v ); } );
+
+        return out;
+    }
+
+private:
+    template< std::size_t K >
+    using codec = typename Codecs::template codec< typename variant_alternative< K, V >::type >;
+
+    template< std::size_t K >
+    using copies_raw = std::integral_constant< bool,
+        variants::detail::codec_is_object_representation< codec<K> >::value
+        && std::is_trivially_default_constructible< typename variant_alternative< K, V >::type >::value >;
+
+    struct begin_payload
+    {
+        variant_decoder & decoder;
+
+        template< std::size_t K >
+        void operator()( std::integral_constant< std::size_t, K > ) const
+        {
+            decoder.template begin<K>( copies_raw<K>() );
+        }
+    };
+
+    struct continue_payload
+    {
+        variant_decoder & decoder;
+        char const * first;
+        char const * last;
+
+        template< std::size_t K >
+        char const * operator()( std::integral_constant< std::size_t, K > ) const
+        {
+            return decoder.template read<K>( first, last, copies_raw<K>() );
+        }
+    };
+
+    char const * read_index( char const * first, char const * last )
+    {
+        for ( ; first != last; )
+        {
+            unsigned char const byte = static_cast<unsigned char>( *first++ );
+
+            if ( variants::detail::varint_overflows( byte, shift_ ) || variants::detail::varint_overlong( byte, shift_ ) )
+            {
+                state_ = malformed;
+                return last;
+            }
+
+            index_ |= static_cast<std::size_t>( byte & 0x7f ) << shift_;
+            shift_ += 7;
+
+            if ( byte < 0x80 )
+            {
+                if ( index_ >= variant_size<V>::value )
+                {
+                    state_ = malformed;
+                    return last;
+                }
+
+                state_ = expect_payload;
+                with_index< variant_size<V>::value >( index_, begin_payload{ *this } );
+
+                return read_payload( first, last );
+            }
+
+            if ( shift_ >= unsigned( std::numeric_limits<std::size_t>::digits ) )
+            {
+                state_ = malformed;
+                return last;
+            }
+        }
+        return first;
+    }
+
+    char const * read_payload( char const * first, char const * last )
+    {
+        return with_index< variant_size<V>::value >( index_, continue_payload{ *this, first, last } );
+    }
+
+    void finish( bool success )
+    {
+        index_ = 0;
+        shift_ = 0;
+        size_  = unknown;
+        state_ = success ? complete : malformed;
+    }
+
+    // trivially copyable payload: copy the input into the emplaced alternative:
+
+    template< std::size_t K >
+    void begin( std::true_type /*copies_raw*/ )
+    {
+        value_.template emplace<K>();
+        filled_ = 0;
+    }
+
+    template< std::size_t K >
+    char const * read( char const * first, char const * last, std::true_type /*copies_raw*/ )
+    {
+        typedef typename variant_alternative< K, V >::type type;
+
+        std::size_t const n = ( std::min )( sizeof( type ) - filled_, static_cast<std::size_t>( last - first ) );
+
+        std::memcpy( reinterpret_cast<char *>( nonstd::get_if<K>( &value_ ) ) + filled_, first, n );
+
+        if ( ( filled_ += n ) == sizeof( type ) )
+        {
+            finish( true );
+        }
+        return first + n;
+    }
+
+    // other payload: decode from the input, or gather it in pending_ first:
+
+    template< std::size_t K >
+    void begin( std::false_type /*copies_raw*/ )
+    {
+        size_ = unknown;
+    }
+
+    template< std::size_t K >
+    char const * read( char const * first, char const * last, std::false_type /*copies_raw*/ )
+    {
+        variants::detail::variant_emplacer< V, K > emplace = { value_ };
+
+        if ( pending_.empty() && size_ == unknown )
+        {
+            std::size_t size = 0;
+
+            if ( codec<K>::framed_size( first, last, size ) )
+            {
+                if ( size > max_payload_ )
+                {
+                    finish( false );
+                    return last;
+                }
+
+                if ( size <= static_cast<std::size_t>( last - first ) )
+                {
+                    char const * const end = codec<K>::decode( first, first + size, emplace );
+
+                    finish( end == first + size );
+                    return first + size;
+                }
+                size_ = size;
+            }
+        }
+
+        while ( first != last )
+        {
+            if ( size_ == unknown )
+            {
+                pending_.push_back( *first++ );
+
+                std::size_t size = 0;
+
+                if ( codec<K>::framed_size( pending_.data(), pending_.data() + pending_.size(), size ) )
+                {
+                    size_ = size;
+                }
+
+                if ( ( size_ == unknown ? pending_.size() : size_ ) > max_payload_ )
+                {
+                    finish( false );
+                    pending_.clear();
+                    return last;
+                }
+            }
+            else
+            {
+                std::size_t const n = ( std::min )( size_ - pending_.size(), static_cast<std::size_t>( last - first ) );
+
+                pending_.insert( pending_.end(), first, first + n );
+                first += n;
+            }
+
+            if ( size_ != unknown && pending_.size() >= size_ )
+            {
+                char const * const end = codec<K>::decode( pending_.data(), pending_.data() + pending_.size(), emplace );
+
+                finish( end == pending_.data() + pending_.size() );
+                pending_.clear();
+                break;
+            }
+        }
+        return first;
+    }
+
+private:
+    std::size_t max_payload_;
+    V value_;
+    std::size_t index_;
+    unsigned shift_;
+    std::size_t filled_;
+    std::size_t size_;
+    state_type state_;
+    std::vector<char> pending_;
+};
+
+template< class V, class Codecs >
+constexpr std::size_t variant_decoder< V, Codecs >::default_max_payload;
+
+} // namespace nonstd
+
+#endif // variant_CPP11_OR_GREATER
+
+#endif // NONSTD_VARIANT_SERIALIZE_HPP
@@ -0,0 +1,280 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Support for the variant-lite companion headers (C++11 and later).
+//
+// The facilities below only use the interface that std::variant and
+// nonstd::variant have in common: index(), get<K>(), emplace<K>(),
+// variant_size<> and variant_alternative<>, so that they can be used
+// with either variant selected as nonstd::variant.
+
+#pragma once
+
+#ifndef NONSTD_VARIANT_UTIL_HPP
+#define NONSTD_VARIANT_UTIL_HPP
+
+#include "variant.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+// constexpr for functions with more than a return statement; variant.hpp does
+// not define it if it selects std::variant, which implies C++17:
+
+#ifndef variant_constexpr14
+# define variant_constexpr14  constexpr
+#endif
+
+namespace nonstd {
+namespace variants {
+namespace detail {
+
+// Switch over [Lo..Lo + N) that turns a run-time index into a compile-time one,
+// with one switch for up to 16 indices, which compilers emit as a jump table, and
+// a balanced binary search over such switches for more; all calls are direct, so
+// the optimizer can inline the whole dispatch, and with C++14 it can be evaluated
+// in a constant expression. An index out of range selects the last index:
+
+template< std::size_t Lo, std::size_t N, bool Split = ( N > 16 ) >
+struct index_dispatch
+{
+    static constexpr std::size_t half = N / 2;
+
+    template< class F >
+    static constexpr auto apply( std::size_t index, F && f )
+        -> decltype( std::forward<F>( f )( std::integral_constant< std::size_t, Lo >() ) )
+    {
+        return index - Lo < half
+            ? index_dispatch< Lo       , half     >::apply( index, std::forward<F>( f ) )
+            : index_dispatch< Lo + half, N - half >::apply( index, std::forward<F>( f ) );
+    }
+};
+
+#define variant_DISPATCH_CASE( k ) \
+            case k: return std::forward<F>( f )( std::integral_constant< std::size_t, Lo + k >() );
+
+#define variant_DISPATCH_CASES_1
+#define variant_DISPATCH_CASES_2   variant_DISPATCH_CASES_1  variant_DISPATCH_CASE(  0 )
+#define variant_DISPATCH_CASES_3   variant_DISPATCH_CASES_2  variant_DISPATCH_CASE(  1 )
+#define variant_DISPATCH_CASES_4   variant_DISPATCH_CASES_3  variant_DISPATCH_CASE(  2 )
+#define variant_DISPATCH_CASES_5   variant_DISPATCH_CASES_4  variant_DISPATCH_CASE(  3 )
+#define variant_DISPATCH_CASES_6   variant_DISPATCH_CASES_5  variant_DISPATCH_CASE(  4 )
+#define variant_DISPATCH_CASES_7   variant_DISPATCH_CASES_6  variant_DISPATCH_CASE(  5 )
+#define variant_DISPATCH_CASES_8   variant_DISPATCH_CASES_7  variant_DISPATCH_CASE(  6 )
+#define variant_DISPATCH_CASES_9   variant_DISPATCH_CASES_8  variant_DISPATCH_CASE(  7 )
+#define variant_DISPATCH_CASES_10  variant_DISPATCH_CASES_9  variant_DISPATCH_CASE(  8 )
+#define variant_DISPATCH_CASES_11  variant_DISPATCH_CASES_10 variant_DISPATCH_CASE(  9 )
+#define variant_DISPATCH_CASES_12  variant_DISPATCH_CASES_11 variant_DISPATCH_CASE( 10 )
+#define variant_DISPATCH_CASES_13  variant_DISPATCH_CASES_12 variant_DISPATCH_CASE( 11 )
+#define variant_DISPATCH_CASES_14  variant_DISPATCH_CASES_13 variant_DISPATCH_CASE( 12 )
+#define variant_DISPATCH_CASES_15  variant_DISPATCH_CASES_14 variant_DISPATCH_CASE( 13 )
+#define variant_DISPATCH_CASES_16  variant_DISPATCH_CASES_15 variant_DISPATCH_CASE( 14 )
+
+#define variant_DISPATCH_SWITCH( n ) \
+template< std::size_t Lo > \
+struct index_dispatch< Lo, n, false > \
+{ \
+    template< class F > \
+    static variant_constexpr14 auto apply( std::size_t index, F && f ) \
+        -> decltype( std::forward<F>( f )( std::integral_constant< std::size_t, Lo >() ) ) \
+    { \
+        switch ( index - Lo ) \
+        { \
+            variant_DISPATCH_CASES_##n \
+            default: return std::forward<F>( f )( std::integral_constant< std::size_t, Lo + n - 1 >() ); \
+        } \
+    } \
+};
+
+variant_DISPATCH_SWITCH(  1 )
+variant_DISPATCH_SWITCH(  2 )
+variant_DISPATCH_SWITCH(  3 )
+variant_DISPATCH_SWITCH(  4 )
+variant_DISPATCH_SWITCH(  5 )
+variant_DISPATCH_SWITCH(  6 )
+variant_DISPATCH_SWITCH(  7 )
+variant_DISPATCH_SWITCH(  8 )
+variant_DISPATCH_SWITCH(  9 )
+variant_DISPATCH_SWITCH( 10 )
+variant_DISPATCH_SWITCH( 11 )
+variant_DISPATCH_SWITCH( 12 )
+variant_DISPATCH_SWITCH( 13 )
+variant_DISPATCH_SWITCH( 14 )
+variant_DISPATCH_SWITCH( 15 )
+variant_DISPATCH_SWITCH( 16 )
+
+#undef variant_DISPATCH_SWITCH
+#undef variant_DISPATCH_CASE
+#undef variant_DISPATCH_CASES_1
+#undef variant_DISPATCH_CASES_2
+#undef variant_DISPATCH_CASES_3
+#undef variant_DISPATCH_CASES_4
+#undef variant_DISPATCH_CASES_5
+#undef variant_DISPATCH_CASES_6
+#undef variant_DISPATCH_CASES_7
+#undef variant_DISPATCH_CASES_8
+#undef variant_DISPATCH_CASES_9
+#undef variant_DISPATCH_CASES_10
+#undef variant_DISPATCH_CASES_11
+#undef variant_DISPATCH_CASES_12
+#undef variant_DISPATCH_CASES_13
+#undef variant_DISPATCH_CASES_14
+#undef variant_DISPATCH_CASES_15
+#undef variant_DISPATCH_CASES_16
+
+// C++11 replacement of std::index_sequence, generated with logarithmic depth:
+
+template< std::size_t... I >
+struct index_list {};
+
+template< class L, class R >
+struct index_list_concat;
+
+template< std::size_t... I, std::size_t... J >
+struct index_list_concat< index_list< I... >, index_list< J... > >
+{
+    typedef index_list< I..., ( sizeof...( I ) + J )... > type;
+};
+
+template< std::size_t N >
+struct make_index_list
+    : index_list_concat< typename make_index_list< N / 2 >::type, typename make_index_list< N - N / 2 >::type > {};
+
+template<>
+struct make_index_list< 0 >
+{
+    typedef index_list<> type;
+};
+
+template<>
+struct make_index_list< 1 >
+{
+    typedef index_list< 0 > type;
+};
+
+template< class F, std::size_t... K >
+constexpr auto make_index_table( F const & f, index_list< K... > )
+    -> std::array< decltype( f( std::integral_constant< std::size_t, 0 >() ) ), sizeof...( K ) >
+{
+    return {{ f( std::integral_constant< std::size_t, K >() )... }};
+}
+
+template< class V, std::size_t K = variant_size<V>::value >
+struct alternatives_are_trivially_copyable
+    : std::integral_constant< bool,
+        std::is_trivially_copyable< typename variant_alternative< K - 1, V >::type >::value
+        && alternatives_are_trivially_copyable< V, K - 1 >::value > {};
+
+template< class V >
+struct alternatives_are_trivially_copyable< V, 0 > : std::true_type {};
+
+template< class T, class V, std::size_t K = variant_size<V>::value >
+struct alternatives_contain
+    : std::integral_constant< bool,
+        std::is_same< T, typename variant_alternative< K - 1, V >::type >::value
+        || alternatives_contain< T, V, K - 1 >::value > {};
+
+template< class T, class V >
+struct alternatives_contain< T, V, 0 > : std::false_type {};
+
+template< class V, std::size_t K = variant_size<V>::value >
+struct alternatives_max_sizeof
+{
+private:
+    static constexpr std::size_t head = sizeof( typename variant_alternative< K - 1, V >::type );
+    static constexpr std::size_t tail = alternatives_max_sizeof< V, K - 1 >::value;
+
+public:
+    static constexpr std::size_t value = head > tail ? head : tail;
+};
+
+template< class V >
+struct alternatives_max_sizeof< V, 0 >
+{
+    static constexpr std::size_t value = 0;
+};
+
+template< class V, std::size_t K = variant_size<V>::value >
+struct alternatives_max_alignof
+{
+private:
+    static constexpr std::size_t head = alignof( typename variant_alternative< K - 1, V >::type );
+    static constexpr std::size_t tail = alternatives_max_alignof< V, K - 1 >::value;
+
+public:
+    static constexpr std::size_t value = head > tail ? head : tail;
+};
+
+template< class V >
+struct alternatives_max_alignof< V, 0 >
+{
+    static constexpr std::size_t value = 1;
+};
+
+template< class T, class V, std::size_t K = 0, bool End = ( K == variant_size<V>::value ) >
+struct alternative_index
+    : std::conditional< std::is_same< T, typename variant_alternative< K, V >::type >::value
+        , std::integral_constant< std::size_t, K >
+        , alternative_index< T, V, K + 1 > >::type {};
+
+template< class T, class V, std::size_t K >
+struct alternative_index< T, V, K, true >
+{
+    static_assert( K != K, "type is not an alternative of the variant." );
+};
+
+} // namespace detail
+} // namespace variants
+
+// non-standard: call f( std::integral_constant<std::size_t, K>() ) with K == index; requires index < N:
+
+template< std::size_t N, class F >
+inline constexpr auto with_index( std::size_t index, F && f )
+    -> decltype( std::forward<F>( f )( std::integral_constant< std::size_t, 0 >() ) )
+{
+    static_assert( N > 0, "with_index<N>() requires N > 0." );
+
+    return variants::detail::index_dispatch< 0, N >::apply( index, std::forward<F>( f ) );
+}
+
+// non-standard: std::array of f( std::integral_constant<std::size_t, K>() ) for K in [0..N),
+// e.g. a table per alternative of a variant, computed at compile time for a constexpr f:
+
+template< std::size_t N, class F >
+inline constexpr auto index_table( F const & f )
+    -> std::array< decltype( f( std::integral_constant< std::size_t, 0 >() ) ), N >
+{
+    static_assert( N > 0, "index_table<N>() requires N > 0." );
+
+    return variants::detail::make_index_table( f, typename variants::detail::make_index_list< N >::type() );
+}
+
+// non-standard: properties of the alternatives of a variant:
+
+template< class V >
+struct variant_is_trivially_copyable : variants::detail::alternatives_are_trivially_copyable< V > {};
+
+template< class V >
+struct variant_max_sizeof : std::integral_constant< std::size_t, variants::detail::alternatives_max_sizeof< V >::value > {};
+
+template< class V >
+struct variant_max_alignof : std::integral_constant< std::size_t, variants::detail::alternatives_max_alignof< V >::value > {};
+
+// non-standard: index of the first alternative of V that is T:
+
+template< class T, class V >
+struct variant_index_of : std::integral_constant< std::size_t, variants::detail::alternative_index< T, V >::value > {};
+
+} // namespace nonstd
+
+#endif // variant_CPP11_OR_GREATER
+
+#endif // NONSTD_VARIANT_UTIL_HPP
@@ -0,0 +1,92 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// C++20 module nonstd.variant, built from nonstd/variant.hpp. An importing
+// translation unit loads the compiled module interface instead of parsing the
+// header and the standard headers it includes. Macros, such as the
+// configuration macros and variant_size_V(), are not exported; configure the
+// header when compiling this module interface unit.
+
+module;
+
+// the standard headers nonstd/variant.hpp includes, outside the module:
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#if defined( variant_CONFIG_PROFILE ) && variant_CONFIG_PROFILE
+# include <atomic>
+# include <mutex>
+# include <typeinfo>
+#endif
+
+export module nonstd.variant;
+
+// the declarations of nonstd/variant.hpp, attached to the global module as
+// when included, so that they mix with code that includes the header:
+
+export extern "C++" {
+#include "nonstd/variant.hpp"
+}
+
+#if variant_USES_STD_VARIANT
+# error "module nonstd.variant provides nonstd::variant, define variant_CONFIG_SELECT_VARIANT=variant_VARIANT_NONSTD"
+#endif
+
+// the names that nonstd/variant.hpp makes available via using namespace variants:
+
+export namespace nonstd {
+
+    using variants::variant;
+    using variants::monostate;
+    using variants::bad_variant_access;
+    using variants::variant_size;
+    using variants::variant_size_v;
+    using variants::variant_alternative;
+    using variants::variant_alternative_t;
+    using variants::variant_npos;
+
+    using nonstd::in_place;
+    using nonstd::in_place_type;
+    using nonstd::in_place_index;
+    using nonstd::in_place_t;
+    using nonstd::in_place_type_t;
+    using nonstd::in_place_index_t;
+
+    using variants::visit;
+    using variants::holds_alternative;
+    using variants::get;
+    using variants::get_if;
+    using variants::swap;
+    using variants::operator==;
+    using variants::operator!=;
+    using variants::operator<;
+    using variants::operator<=;
+    using variants::operator>;
+    using variants::operator>=;
+
+    using variants::holds_any_of;
+    using variants::alternative_set;
+
+    using variants::count_alternative;
+    using variants::find_alternative;
+    using variants::partition_by_index;
+    using variants::index_histogram;
+}
+
+// end of file
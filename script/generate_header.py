@@ -4,29 +4,95 @@
 from __future__ import print_function
 
 import argparse
+import os
+import resource
+import shutil
+import subprocess
+import tempfile
 
 from jinja2 import Template, Environment, FileSystemLoader
 
 def_max_types = 16
 def_max_args = 5
+def_max_switch_cases = 16
+def_compiler = 'c++'
 
-def ProcessTemplate(src, dst, types, args, verbose):
-    """Edit variant header template to variant header supporting the specified 
-    maximum number of variant types and of visitor arguments."""
+def ProcessTemplate(src, dst, types, args, verbose, switch_cases=def_max_switch_cases):
+    """Edit variant header template to variant header supporting the specified
+    maximum number of variant types and of visitor arguments. Index dispatch uses
+    one switch for up to switch_cases alternatives and a balanced binary search
+    over such switches for more."""
+
+    switch_cases = max(1, min(switch_cases, types))
 
     if verbose:
-        print( "Generating '{hdr}' with max {tcnt} types, max {acnt} visitor arguments from '{tpl}':".format( tpl=src, hdr=dst, tcnt=types, acnt=args ) )
-        
+        print( "Generating '{hdr}' with max {tcnt} types, max {acnt} visitor arguments, max {scnt} switch cases from '{tpl}':".format( tpl=src, hdr=dst, tcnt=types, acnt=args, scnt=switch_cases ) )
+
     loader = FileSystemLoader('.')
     env = Environment(loader=loader)
 
     tpl = env.get_template(src)
-    result = tpl.render(NumParams=types, VisitorArgs=args)
+    result = tpl.render(NumParams=types, VisitorArgs=args, SwitchCases=switch_cases)
 #    print (result)
     fout = open(dst, 'wt')
     fout.write(result + '\n')
     fout.close()
 
+def CompileSeconds(compiler, std, include, source, workdir):
+    """User CPU time in seconds to compile source, None if it fails."""
+
+    path = os.path.join(workdir, 'probe.cpp')
+
+    with open(path, 'w') as f:
+        f.write(source)
+
+    command = [compiler, '-std=' + std, '-fsyntax-only', '-I' + include, '-Dvariant_CONFIG_SELECT_VARIANT=variant_VARIANT_NONSTD', path]
+
+    before = resource.getrusage(resource.RUSAGE_CHILDREN).ru_utime
+    result = subprocess.call(command)
+    after  = resource.getrusage(resource.RUSAGE_CHILDREN).ru_utime
+
+    return after - before if result == 0 else None
+
+def ReportHeader(dst, types, compiler, std):
+    """Print size of the generated header and an estimate of its compile time:
+    the time to parse it and the time per variant with two alternatives and with
+    the maximum number of alternatives, each assigned, compared and visited."""
+
+    text = open(dst).read()
+
+    print( "Header '{hdr}': {size} bytes, {lines} lines".format( hdr=dst, size=len(text), lines=text.count('\n') ) )
+
+    if not compiler:
+        return
+
+    def tu(variants, alternatives):
+        lines = ['#include "nonstd/variant.hpp"', 'template< int N > struct a { int v; bool operator==( a const & ) const { return true; } bool operator<( a const & ) const { return false; } };', 'struct f { template< class T > int operator()( T const & t ) const { return t.v; } };']
+        for i in range(variants):
+            types = ', '.join('a<{}>'.format(i * alternatives + k) for k in range(alternatives))
+            lines.append('typedef nonstd::variant< {t} > v{i}; int g{i}( v{i} & x, v{i} const & y ) {{ x = y; return ( x == y ) + ( x < y ) + nonstd::visit( f(), x ); }}'.format(t=types, i=i))
+        return '\n'.join(lines) + '\n'
+
+    workdir = tempfile.mkdtemp(prefix='variant-header-')
+    try:
+        os.makedirs(os.path.join(workdir, 'include', 'nonstd'))
+        shutil.copy(dst, os.path.join(workdir, 'include', 'nonstd', 'variant.hpp'))
+        include = os.path.join(workdir, 'include')
+
+        variants = 20
+        parse = CompileSeconds(compiler, std, include, tu(0, 0), workdir)
+        small = CompileSeconds(compiler, std, include, tu(variants, 2), workdir)
+        large = CompileSeconds(compiler, std, include, tu(variants, types), workdir)
+
+        if None in (parse, small, large):
+            print( "Compile-time estimate: '{cxx}' failed".format( cxx=compiler ) )
+            return
+
+        print( "Compile-time estimate ({cxx}, {std}): parse {p:.2f}s, per variant of 2 types {s:.3f}s, of {n} types {l:.3f}s".format(
+            cxx=compiler, std=std, p=parse, s=(small - parse) / variants, n=types, l=(large - parse) / variants ) )
+    finally:
+        shutil.rmtree(workdir)
+
 def main():
     parser = argparse.ArgumentParser(
         description='Generate variant header from template header file.',
@@ -52,9 +118,37 @@ def main():
         default=def_max_args,
         help='number of arguments for \'visit\' methods')
 
+    parser.add_argument(
+        '--max-switch-cases',
+        metavar='cases',
+        type=int,
+        default=def_max_switch_cases,
+        help='number of cases of a dispatch switch, more alternatives use a binary search over switches')
+
+    parser.add_argument(
+        '--report',
+        action='store_true',
+        help='report header size and, with --compiler, an estimate of its compile time')
+
+    parser.add_argument(
+        '--compiler',
+        metavar='cxx',
+        default=None,
+        help='compiler for the compile-time estimate of --report, e.g. ' + def_compiler)
+
+    parser.add_argument(
+        '--std',
+        metavar='std',
+        default='c++11',
+        help='C++ standard for the compile-time estimate of --report')
+
     opt = parser.parse_args()
 
-    ProcessTemplate('template/variant.hpp', 'include/nonstd/variant.hpp', opt.max_types, opt.max_args, opt.verbose)
+    ProcessTemplate('template/variant.hpp', 'include/nonstd/variant.hpp', opt.max_types, opt.max_args, opt.verbose, opt.max_switch_cases)
+    ProcessTemplate('template/variant_fwd.hpp', 'include/nonstd/variant_fwd.hpp', opt.max_types, opt.max_args, opt.verbose, opt.max_switch_cases)
+
+    if opt.report:
+        ReportHeader('include/nonstd/variant.hpp', opt.max_types, opt.compiler, opt.std)
 
 if __name__== "__main__":
   main()
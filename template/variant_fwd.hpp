@@ -0,0 +1,79 @@
+{% from 'template/variant.hpp' import configuration, forward_declarations with context -%}
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Declarations of variant with its default template arguments, monostate,
+// variant_size, variant_alternative and bad_variant_access, for headers that
+// only name these types. Include nonstd/variant.hpp to use them.
+// Generated with nonstd/variant.hpp by script/generate_header.py.
+
+#pragma once
+
+#ifndef NONSTD_VARIANT_LITE_FWD_HPP
+#define NONSTD_VARIANT_LITE_FWD_HPP
+
+{{ configuration() }}
+
+#if variant_USES_STD_VARIANT
+
+#include <variant>
+
+namespace nonstd {
+
+    using std::variant;
+    using std::monostate;
+    using std::bad_variant_access;
+    using std::variant_size;
+    using std::variant_alternative;
+}
+
+#else // variant_USES_STD_VARIANT
+
+#include <cstddef>
+
+namespace nonstd { namespace variants {
+
+{{ forward_declarations() }}
+
+#ifdef variant_CONFIG_OVERRIDE_MONOSTATE
+using variant_CONFIG_OVERRIDE_MONOSTATE;
+#else
+class monostate;
+#endif
+
+template< class T >
+struct variant_size;
+
+template< std::size_t K, class T >
+struct variant_alternative;
+
+#if ! variant_CONFIG_NO_EXCEPTIONS
+# ifdef variant_CONFIG_OVERRIDE_BAD_VARIANT_ACCESS
+using variant_CONFIG_OVERRIDE_BAD_VARIANT_ACCESS;
+# else
+class bad_variant_access;
+# endif
+#endif
+
+} // namespace variants
+
+// using-declarations: a using-directive here would make variants::detail
+// collide with nonstd::detail of nonstd/variant.hpp:
+
+using variants::variant;
+using variants::monostate;
+using variants::variant_size;
+using variants::variant_alternative;
+#if ! variant_CONFIG_NO_EXCEPTIONS
+using variants::bad_variant_access;
+#endif
+
+} // namespace nonstd
+
+#endif // variant_USES_STD_VARIANT
+
+#endif // NONSTD_VARIANT_LITE_FWD_HPP
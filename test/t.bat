@@ -29,7 +29,7 @@ set msvc_defines=^
 
 set CppCoreCheckInclude=%VCINSTALLDIR%\Auxiliary\VS\include
 
-cl -nologo -W3 -EHsc %std% %unit_select% %unit_config% %msvc_defines% -I"%CppCoreCheckInclude%" -Ilest -I../include -I. %unit%-main.t.cpp %unit%.t.cpp %unit%-override.t.cpp && %unit%-main.t.exe
+cl -nologo -W3 -EHsc %std% %unit_select% %unit_config% %msvc_defines% -I"%CppCoreCheckInclude%" -Ilest -I../include -I. %unit%-main.t.cpp %unit%.t.cpp %unit%-serialize.t.cpp %unit%-mapped.t.cpp %unit%-format.t.cpp %unit%-atomic.t.cpp %unit%-seqlock.t.cpp %unit%-ring.t.cpp %unit%-fsm.t.cpp %unit%-instantiate.t.cpp %unit%-fwd.t.cpp %unit%-match.t.cpp %unit%-profile.t.cpp %unit%-accounting.t.cpp %unit%-override.t.cpp && %unit%-main.t.exe
 endlocal & goto :EOF
 
 :: subroutines:
@@ -29,7 +29,7 @@ rem -flto / -fwhole-program
 set  optflags=-O2
 set warnflags=-Wall -Wextra -Wpedantic -Wconversion -Wsign-conversion -Wno-padded -Wno-missing-noreturn
 
-%gpp% -std=%std% %optflags% %warnflags% %unit_select% %unit_config% -o %unit%-main.t.exe -isystem lest -I../include -I. %unit%-main.t.cpp %unit%.t.cpp %unit%-override.t.cpp && %unit%-main.t.exe
+%gpp% -std=%std% %optflags% %warnflags% %unit_select% %unit_config% -o %unit%-main.t.exe -isystem lest -I../include -I. %unit%-main.t.cpp %unit%.t.cpp %unit%-serialize.t.cpp %unit%-mapped.t.cpp %unit%-format.t.cpp %unit%-atomic.t.cpp %unit%-seqlock.t.cpp %unit%-ring.t.cpp %unit%-fsm.t.cpp %unit%-instantiate.t.cpp %unit%-fwd.t.cpp %unit%-match.t.cpp %unit%-profile.t.cpp %unit%-accounting.t.cpp %unit%-override.t.cpp && %unit%-main.t.exe
 
 endlocal & goto :EOF
 
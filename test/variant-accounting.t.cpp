@@ -0,0 +1,192 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Copies, moves, assignments, destructions and heap allocations of the
+// alternative per operation on a variant, against the baseline below.
+// An operation that starts to copy or move more than it did fails here.
+// The baseline is that of nonstd::variant; std::variant may differ.
+
+#include "variant-main.t.hpp"
+
+#if variant_CPP11_OR_GREATER && ! variant_USES_STD_VARIANT
+
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+struct counts
+{
+    int copies;
+    int moves;
+    int copy_assigns;
+    int move_assigns;
+    int destructions;
+    int allocations;
+};
+
+counts accounted = {};
+
+// copies like a type that allocates, moves without exceptions:
+
+struct counted
+{
+    int value;
+
+    counted( int v ) : value( v ) {}
+
+    counted( counted const & other ) : value( other.value ) { ++accounted.copies; }
+    counted( counted && other ) noexcept : value( other.value ) { ++accounted.moves; }
+
+    counted & operator=( counted const & other ) { value = other.value; ++accounted.copy_assigns; return *this; }
+    counted & operator=( counted && other ) noexcept { value = other.value; ++accounted.move_assigns; return *this; }
+
+    ~counted() { ++accounted.destructions; }
+};
+
+inline bool operator==( counted const & a, counted const & b ) { return a.value == b.value; }
+inline bool operator< ( counted const & a, counted const & b ) { return a.value <  b.value; }
+
+struct counted_value
+{
+    int operator()( counted const & c ) const { return c.value; }
+    int operator()( int i ) const { return i; }
+};
+
+} // anonymous namespace
+
+namespace std {
+
+template<>
+struct hash< counted >
+{
+    std::size_t operator()( counted const & c ) const { return std::hash<int>()( c.value ); }
+};
+
+} // namespace std
+
+// count the allocations of the whole program:
+
+void * operator new( std::size_t size )
+{
+    ++accounted.allocations;
+
+    if ( void * p = std::malloc( size ? size : 1 ) )
+    {
+        return p;
+    }
+#if variant_CONFIG_NO_EXCEPTIONS
+    std::abort();
+#else
+    throw std::bad_alloc();
+#endif
+}
+
+void operator delete( void * p ) noexcept
+{
+    std::free( p );
+}
+
+#if variant_CPP14_OR_GREATER
+void operator delete( void * p, std::size_t ) noexcept
+{
+    std::free( p );
+}
+#endif
+
+namespace {
+
+using nonstd::variant;
+using nonstd::get;
+using nonstd::get_if;
+using nonstd::in_place_type;
+using nonstd::visit;
+
+typedef variant< counted, int > counted_t;
+
+void start() { accounted = counts(); }
+
+counts stop() { return accounted; }
+
+struct accounting
+{
+    char const * operation;
+    counts ( * measure )();
+    counts expected;
+};
+
+// the counts of an operation, as reported by lest:
+
+struct measurement
+{
+    char const * operation;
+    counts c;
+};
+
+inline bool operator==( measurement const & a, measurement const & b )
+{
+    return a.c.copies       == b.c.copies       && a.c.moves        == b.c.moves
+        && a.c.copy_assigns == b.c.copy_assigns && a.c.move_assigns == b.c.move_assigns
+        && a.c.destructions == b.c.destructions && a.c.allocations  == b.c.allocations;
+}
+
+inline std::ostream & operator<<( std::ostream & os, measurement const & m )
+{
+    return os << m.operation << ": { " << m.c.copies << ", " << m.c.moves << ", " << m.c.copy_assigns
+              << ", " << m.c.move_assigns << ", " << m.c.destructions << ", " << m.c.allocations << " }";
+}
+
+// The baseline: the operations and their counts of
+// { copies, moves, copy-assigns, move-assigns, destructions, allocations }.
+// Update an entry only for an intended change in behaviour:
+
+accounting const baseline[] =
+{
+    { "construct from lvalue"           , []{ counted c( 1 );      start(); counted_t v( c );                            return stop(); }, { 1, 0, 0, 0, 0, 0 } },
+    { "construct from rvalue"           , []{ counted c( 1 );      start(); counted_t v( std::move( c ) );               return stop(); }, { 0, 1, 0, 0, 0, 0 } },
+    { "construct in place"              , []{                      start(); counted_t v( in_place_type<counted>, 1 );    return stop(); }, { 0, 0, 0, 0, 0, 0 } },
+    { "copy-construct"                  , []{ counted_t w( counted( 1 ) ); start(); counted_t v( w );                            return stop(); }, { 1, 0, 0, 0, 0, 0 } },
+    { "move-construct"                  , []{ counted_t w( counted( 1 ) ); start(); counted_t v( std::move( w ) );               return stop(); }, { 0, 1, 0, 0, 0, 0 } },
+    { "copy-assign, same alternative"   , []{ counted_t v( counted( 1 ) ), w( counted( 2 ) ); start(); v = w;                                 return stop(); }, { 0, 0, 1, 0, 0, 0 } },
+    { "copy-assign, other alternative"  , []{ counted_t v( 7 ), w( counted( 2 ) ); start(); v = w;                       return stop(); }, { 1, 0, 0, 0, 0, 0 } },
+    { "move-assign, same alternative"   , []{ counted_t v( counted( 1 ) ), w( counted( 2 ) ); start(); v = std::move( w );                    return stop(); }, { 0, 0, 0, 1, 0, 0 } },
+    { "move-assign, other alternative"  , []{ counted_t v( 7 ), w( counted( 2 ) ); start(); v = std::move( w );          return stop(); }, { 0, 1, 0, 0, 0, 0 } },
+    { "assign lvalue, same alternative" , []{ counted_t v( counted( 1 ) ); counted c( 2 ); start(); v = c;               return stop(); }, { 0, 0, 1, 0, 0, 0 } },
+    { "assign lvalue, other alternative", []{ counted_t v( 7 ); counted c( 2 );            start(); v = c;               return stop(); }, { 1, 1, 0, 0, 1, 0 } },
+    { "assign rvalue, same alternative" , []{ counted_t v( counted( 1 ) ); counted c( 2 ); start(); v = std::move( c );  return stop(); }, { 0, 0, 0, 1, 0, 0 } },
+    { "assign rvalue, other alternative", []{ counted_t v( 7 ); counted c( 2 );            start(); v = std::move( c );  return stop(); }, { 0, 1, 0, 0, 0, 0 } },
+    { "assign other alternative value"  , []{ counted_t v( counted( 1 ) );                 start(); v = 7;               return stop(); }, { 0, 0, 0, 0, 1, 0 } },
+    { "emplace in place"                , []{ counted_t v( counted( 1 ) );      start(); v.emplace<counted>( 2 );        return stop(); }, { 0, 0, 0, 0, 1, 0 } },
+    { "emplace from rvalue"             , []{ counted_t v( 7 ); counted c( 2 ); start(); v.emplace<0>( std::move( c ) ); return stop(); }, { 0, 1, 0, 0, 0, 0 } },
+    { "swap, same alternative"          , []{ counted_t v( counted( 1 ) ), w( counted( 2 ) ); start(); v.swap( w );      return stop(); }, { 0, 1, 0, 2, 1, 0 } },
+    { "swap, other alternatives"        , []{ counted_t v( counted( 1 ) ), w( 7 );            start(); v.swap( w );      return stop(); }, { 0, 2, 0, 0, 2, 0 } },
+    { "visit"                           , []{ counted_t v( counted( 1 ) ); start(); visit( counted_value(), v );          return stop(); }, { 0, 0, 0, 0, 0, 0 } },
+    { "get and get_if"                  , []{ counted_t v( counted( 1 ) ); start(); get<counted>( v ); get_if<0>( &v );  return stop(); }, { 0, 0, 0, 0, 0, 0 } },
+    { "compare"                         , []{ counted_t v( counted( 1 ) ), w( 7 ); start(); (void)( v == w ); (void)( v < w ); return stop(); }, { 0, 0, 0, 0, 0, 0 } },
+    { "hash"                            , []{ counted_t v( counted( 1 ) ); start(); std::hash< counted_t >()( v );        return stop(); }, { 0, 0, 0, 0, 0, 0 } },
+};
+
+} // anonymous namespace
+
+#endif // variant_CPP11_OR_GREATER && ! variant_USES_STD_VARIANT
+
+CASE( "accounting: Allows no more copies, moves and allocations per operation than the baseline (C++11)" )
+{
+#if variant_CPP11_OR_GREATER && ! variant_USES_STD_VARIANT
+    for ( accounting const & entry : baseline )
+    {
+        measurement const measured = { entry.operation, entry.measure()  };
+        measurement const expected = { entry.operation, entry.expected };
+
+        EXPECT( measured == expected );
+    }
+#else
+    EXPECT( !!"accounting: not available (no C++11, or std::variant)" );
+#endif
+}
+
+// end of file
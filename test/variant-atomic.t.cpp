@@ -0,0 +1,188 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "variant-main.t.hpp"
+#include "nonstd/variant_atomic.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+namespace {
+
+struct Idle {};
+
+struct Running
+{
+    int tid;
+};
+
+struct Paused
+{
+    int ts;
+};
+
+struct Large
+{
+    char data[32];
+};
+
+// padding bytes between c and i:
+
+struct Padded
+{
+    char c;
+    int i;
+};
+
+// the same members, with the padding made explicit:
+
+struct Unpadded
+{
+    char c;
+    char pad[3];
+    int i;
+};
+
+typedef nonstd::variant< Idle, Running, Paused > state_t;
+
+struct state_name
+{
+    char const * operator()( Idle    const & ) const { return "idle"; }
+    char const * operator()( Running const & ) const { return "running"; }
+    char const * operator()( Paused  const & ) const { return "paused"; }
+};
+
+} // anonymous namespace
+
+// where the compiler cannot tell, declare that Unpadded has no padding bytes:
+
+namespace nonstd {
+
+template<>
+struct atomic_variant_bitwise_comparable< Unpadded > : std::true_type {};
+
+} // namespace nonstd
+
+#endif // variant_CPP11_OR_GREATER
+
+CASE( "atomic_variant: Allows to load, store and exchange a variant (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    nonstd::atomic_variant< state_t > state;
+
+    EXPECT( state.load().index() == 0u );
+
+    state.store( Running{ 7 } );
+
+    EXPECT( state.index() == 1u );
+    EXPECT( nonstd::get<Running>( state.load() ).tid == 7 );
+
+    state_t const previous = state.exchange( Paused{ 42 } );
+
+    EXPECT( nonstd::get<Running>( previous ).tid == 7 );
+    EXPECT( nonstd::get<Paused>( state.load( std::memory_order_acquire ) ).ts == 42 );
+#else
+    EXPECT( !!"atomic_variant: not available (no C++11)" );
+#endif
+}
+
+CASE( "atomic_variant: Allows to compare and exchange a variant (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    nonstd::atomic_variant< state_t > state( state_t( Running{ 7 } ) );
+
+    state_t expected = Idle();
+
+    EXPECT_NOT( state.compare_exchange_strong( expected, Paused{ 1 } ) );
+    EXPECT( nonstd::get<Running>( expected ).tid == 7 );
+
+    EXPECT( state.compare_exchange_strong( expected, Idle() ) );
+    EXPECT( state.index() == 0u );
+
+    expected = Idle();
+
+    while ( ! state.compare_exchange_weak( expected, Running{ 8 }, std::memory_order_acq_rel ) ) {}
+
+    EXPECT( nonstd::get<Running>( state.load() ).tid == 8 );
+#else
+    EXPECT( !!"atomic_variant: not available (no C++11)" );
+#endif
+}
+
+CASE( "atomic_variant: Requires alternatives without padding bytes (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    EXPECT(     nonstd::atomic_variant_bitwise_comparable< Idle     >::value );
+    EXPECT(     nonstd::atomic_variant_bitwise_comparable< int      >::value );
+    EXPECT(     nonstd::atomic_variant_bitwise_comparable< double   >::value );
+    EXPECT(     nonstd::atomic_variant_bitwise_comparable< Unpadded >::value );
+    EXPECT_NOT( nonstd::atomic_variant_bitwise_comparable< Padded   >::value );
+
+    typedef nonstd::variant< Idle, Unpadded > var_t;
+
+    nonstd::atomic_variant< var_t > state( var_t( Unpadded{ 'a', {}, 1 } ) );
+
+    var_t expected = Unpadded{ 'a', {}, 1 };
+
+    while ( ! state.compare_exchange_weak( expected, Unpadded{ 'b', {}, 2 } ) ) {}
+
+    EXPECT( nonstd::get<Unpadded>( state.load() ).i == 2 );
+#else
+    EXPECT( !!"atomic_variant: not available (no C++11)" );
+#endif
+}
+
+CASE( "atomic_variant: Allows to visit the current value (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    nonstd::atomic_variant< state_t > state( state_t( Paused{ 3 } ) );
+
+    EXPECT( std::string( "paused" ) == state.visit_current( state_name() ) );
+#else
+    EXPECT( !!"atomic_variant: not available (no C++11)" );
+#endif
+}
+
+CASE( "atomic_variant: Is lock-free for variants that fit in 8 bytes (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::atomic_variant< state_t > atomic_t;
+
+    atomic_t state;
+
+    EXPECT( state.is_lock_free() == ( ATOMIC_LLONG_LOCK_FREE == 2 ) );
+    EXPECT( atomic_t::is_always_lock_free == ( ATOMIC_LLONG_LOCK_FREE == 2 ) );
+#else
+    EXPECT( !!"atomic_variant: not available (no C++11)" );
+#endif
+}
+
+CASE( "atomic_variant: Reports a lock for variants that do not fit in 16 bytes (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, long long, Large > var_t;
+
+    nonstd::atomic_variant< var_t > wide( var_t( 5LL ) );
+    nonstd::atomic_variant< nonstd::variant< int, long long > > dword;
+
+    EXPECT_NOT( wide.is_lock_free() );
+    EXPECT( dword.is_lock_free() == bool( variant_HAVE_DWCAS ) );
+
+    var_t expected = 5LL;
+    Large large = {};
+    large.data[31] = 'z';
+
+    EXPECT( wide.compare_exchange_strong( expected, large ) );
+    EXPECT( nonstd::get<Large>( wide.load() ).data[31] == 'z' );
+
+    dword.store( 9LL );
+    EXPECT( nonstd::get<long long>( dword.load() ) == 9LL );
+#else
+    EXPECT( !!"atomic_variant: not available (no C++11)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,175 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "variant-main.t.hpp"
+#include "nonstd/variant_format.hpp"
+
+#include <climits>
+#include <iterator>
+#include <string>
+
+#if variant_CPP11_OR_GREATER
+
+namespace {
+
+enum Color { red = 1, green = 2 };
+
+struct Point
+{
+    int x, y;
+};
+
+// a type whose formatter always fails:
+
+struct Unformattable {};
+
+template< class V >
+std::string format( V const & v, std::size_t size = 64 )
+{
+    std::string buffer( size, '\0' );
+
+    char * end = nonstd::format_to( &buffer[0], buffer.size(), v );
+
+    return end ? std::string( &buffer[0], end ) : std::string( "[too small]" );
+}
+
+} // anonymous namespace
+
+namespace nonstd {
+
+template<>
+struct variant_formatter< Point >
+{
+    static char * format( Point const & p, char * first, char * last )
+    {
+        char * pos = first;
+
+        if ( ( pos = variant_formatter<char>::format( '(', pos, last ) ) == nullptr ) return nullptr;
+        if ( ( pos = variant_formatter<int >::format( p.x, pos, last ) ) == nullptr ) return nullptr;
+        if ( ( pos = variant_formatter<char>::format( ',', pos, last ) ) == nullptr ) return nullptr;
+        if ( ( pos = variant_formatter<int >::format( p.y, pos, last ) ) == nullptr ) return nullptr;
+
+        return variant_formatter<char>::format( ')', pos, last );
+    }
+};
+
+template<>
+struct variant_formatter< Unformattable >
+{
+    static char * format( Unformattable const &, char *, char * )
+    {
+        return nullptr;
+    }
+};
+
+} // namespace nonstd
+
+#endif // variant_CPP11_OR_GREATER
+
+CASE( "format: Allows to format integral and enumeration alternatives (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, unsigned long long, long long, short, Color > var_t;
+
+    EXPECT( "0"                    == format( var_t( 0 ) ) );
+    EXPECT( "-42"                  == format( var_t( -42 ) ) );
+    EXPECT( "18446744073709551615" == format( var_t( ULLONG_MAX ) ) );
+    EXPECT( "-9223372036854775808" == format( var_t( LLONG_MIN ) ) );
+    EXPECT( "7"                    == format( var_t( short( 7 ) ) ) );
+    EXPECT( "2"                    == format( var_t( green ) ) );
+#else
+    EXPECT( !!"format: not available (no C++11)" );
+#endif
+}
+
+CASE( "format: Allows to format floating point alternatives (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< double, float > var_t;
+
+    EXPECT( "2.5"   == format( var_t( 2.5 ) ) );
+    EXPECT( "-0.25" == format( var_t( -0.25f ) ) );
+    EXPECT( "1e+100" == format( var_t( 1e100 ) ) );
+#else
+    EXPECT( !!"format: not available (no C++11)" );
+#endif
+}
+
+CASE( "format: Allows to format monostate, bool, char and string alternatives (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< nonstd::monostate, bool, char, std::string, char const * > var_t;
+
+    EXPECT( "monostate" == format( var_t() ) );
+    EXPECT( "true"      == format( var_t( true ) ) );
+    EXPECT( "x"         == format( var_t( 'x' ) ) );
+    EXPECT( "hello"     == format( var_t( std::string( "hello" ) ) ) );
+    EXPECT( "world"     == format( var_t( nonstd::in_place_index<4>, "world" ) ) );
+    EXPECT( "(null)"    == format( var_t( nonstd::in_place_index<4>, nullptr ) ) );
+#else
+    EXPECT( !!"format: not available (no C++11)" );
+#endif
+}
+
+CASE( "format: Allows to provide a formatter for a user-defined type (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, Point > var_t;
+
+    EXPECT( "(3,4)" == format( var_t( Point{ 3, 4 } ) ) );
+#else
+    EXPECT( !!"format: not available (no C++11)" );
+#endif
+}
+
+CASE( "format: Reports a buffer that is too small (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, std::string, Point > var_t;
+
+    EXPECT( "[too small]" == format( var_t( 12345 ), 4 ) );
+    EXPECT( "[too small]" == format( var_t( std::string( "hello" ) ), 4 ) );
+    EXPECT( "[too small]" == format( var_t( Point{ 3, 4 } ), 4 ) );
+    EXPECT( "1234"        == format( var_t( 1234 ), 4 ) );
+#else
+    EXPECT( !!"format: not available (no C++11)" );
+#endif
+}
+
+CASE( "format: Allows to format to an output iterator, regardless of length (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, std::string > var_t;
+
+    std::string text;
+
+    nonstd::format_to( std::back_inserter( text ), var_t( 42 ) );
+    nonstd::format_to( std::back_inserter( text ), var_t( std::string( 1000, 'x' ) ) );
+
+    EXPECT( 1002u == text.size() );
+    EXPECT( "42x" == text.substr( 0, 3 ) );
+#else
+    EXPECT( !!"format: not available (no C++11)" );
+#endif
+}
+
+CASE( "format: Writes nothing to an output iterator if the formatter fails (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, Unformattable > var_t;
+
+    std::string text;
+
+    nonstd::format_to( std::back_inserter( text ), var_t( Unformattable() ) );
+
+    EXPECT( text.empty() );
+#else
+    EXPECT( !!"format: not available (no C++11)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,129 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "variant-main.t.hpp"
+#include "nonstd/variant_fsm.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+namespace {
+
+struct event_start {};
+struct event_pause {};
+struct event_stop  {};
+struct event_tick  {};
+
+struct state_idle {};
+struct state_paused {};
+
+// counts copies of the running state:
+
+struct state_running
+{
+    static int copied;
+
+    int ticks;
+
+    explicit state_running( int t = 0 ) : ticks( t ) {}
+    state_running( state_running const & other ) : ticks( other.ticks ) { ++copied; }
+    state_running( state_running && other ) : ticks( other.ticks ) {}
+};
+
+int state_running::copied = 0;
+
+typedef nonstd::variant< state_idle, state_running, state_paused > state_t;
+typedef nonstd::variant< event_start, event_pause, event_stop, event_tick > event_t;
+
+struct transitions
+{
+    int stays;
+
+    transitions() : stays( 0 ) {}
+
+    state_running on_event( state_idle &  , event_start const & ) { return state_running(); }
+    state_paused  on_event( state_running &, event_pause const & ) { return state_paused(); }
+    state_idle    on_event( state_running &, event_stop  const & ) { return state_idle(); }
+    void          on_event( state_running & s, event_tick const & ) { ++s.ticks; }
+    state_running on_event( state_paused &, event_start const & ) { return state_running( 100 ); }
+    nonstd::fsm_stay on_event( state_paused &, event_tick const & ) { ++stays; return nonstd::fsm_stay(); }
+};
+
+typedef nonstd::fsm< state_t, event_t, transitions > machine_t;
+
+} // anonymous namespace
+
+#endif // variant_CPP11_OR_GREATER
+
+CASE( "fsm: Allows to dispatch events and to take transitions (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    machine_t m;
+
+    EXPECT( m.is_in<state_idle>() );
+    EXPECT(     m.dispatch( event_start() ) );
+    EXPECT( m.is_in<state_running>() );
+    EXPECT(     m.dispatch( event_pause() ) );
+    EXPECT( m.is_in<state_paused>() );
+    EXPECT(     m.dispatch( event_start() ) );
+    EXPECT( m.is_in<state_running>() );
+    EXPECT( nonstd::get<state_running>( m.state() ).ticks == 100 );
+    EXPECT(     m.dispatch( event_stop() ) );
+    EXPECT( m.is_in<state_idle>() );
+#else
+    EXPECT( !!"fsm: not available (no C++11)" );
+#endif
+}
+
+CASE( "fsm: Allows to dispatch an event held in a variant (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    machine_t m;
+
+    EXPECT( m.dispatch( event_t( event_start() ) ) );
+    EXPECT( m.dispatch( event_t( event_pause() ) ) );
+    EXPECT( m.is_in<state_paused>() );
+#else
+    EXPECT( !!"fsm: not available (no C++11)" );
+#endif
+}
+
+CASE( "fsm: Allows to stay in a state, with or without action (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    machine_t m( state_t( state_paused{} ) );
+
+    EXPECT_NOT( m.dispatch( event_tick() ) );
+    EXPECT_NOT( m.dispatch( event_stop() ) );
+    EXPECT( m.is_in<state_paused>() );
+    EXPECT( m.transitions().stays == 1 );
+
+    EXPECT( m.dispatch( event_start() ) );
+    EXPECT_NOT( m.dispatch( event_tick() ) );
+    EXPECT_NOT( m.dispatch( event_t( event_tick() ) ) );
+    EXPECT( nonstd::get<state_running>( m.state() ).ticks == 102 );
+#else
+    EXPECT( !!"fsm: not available (no C++11)" );
+#endif
+}
+
+CASE( "fsm: Transitions without copying the state variant (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    machine_t m;
+
+    state_running::copied = 0;
+
+    m.dispatch( event_start() );
+    m.dispatch( event_tick() );
+
+    EXPECT( state_running::copied == 0 );
+#else
+    EXPECT( !!"fsm: not available (no C++11)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,61 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Use the declarations before nonstd/variant.hpp is included:
+
+#include "nonstd/variant_fwd.hpp"
+
+namespace {
+
+typedef nonstd::variant< int, char > Small;
+
+struct Holder
+{
+    Small const * value;
+    nonstd::monostate const * none;
+};
+
+std::size_t index_of( Small const & v );
+
+template< class V >
+struct Size
+{
+    static std::size_t get() { return nonstd::variant_size< V >::value; }
+};
+
+} // anonymous namespace
+
+#include "variant-main.t.hpp"
+
+namespace {
+
+std::size_t index_of( Small const & v )
+{
+    return v.index();
+}
+
+} // anonymous namespace
+
+CASE( "fwd: Allows to name variant with its default template arguments before its definition" )
+{
+    Small const v( 'x' );
+    Holder const h = { &v, 0 };
+
+    EXPECT( index_of( *h.value ) == 1u );
+    EXPECT( nonstd::holds_alternative< char >( v ) );
+}
+
+CASE( "fwd: Allows to name monostate and variant_size before their definition" )
+{
+    nonstd::variant< nonstd::monostate, int > const m;
+    Holder const h = { 0, &nonstd::get< nonstd::monostate >( m ) };
+
+    EXPECT( h.none != static_cast< nonstd::monostate const * >( 0 ) );
+    EXPECT( Size< Small >::get() == 2u );
+}
+
+// end of file
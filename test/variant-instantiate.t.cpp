@@ -0,0 +1,84 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "variant-main.t.hpp"
+
+#include <string>
+#include <vector>
+
+// without C++11, the macros expand to nothing:
+
+namespace {
+
+typedef nonstd::variant< int, std::string, std::vector<int> > Value;
+typedef nonstd::variant< char, std::string > Key;
+
+struct length
+{
+    std::size_t operator()( int ) const { return 1; }
+    std::size_t operator()( std::string const & s ) const { return s.size(); }
+    std::size_t operator()( std::vector<int> const & v ) const { return v.size(); }
+};
+
+} // anonymous namespace
+
+// declare here, define at the end of this file:
+
+variant_EXTERN_INSTANTIATE( Value )
+variant_EXTERN_INSTANTIATE_COMPARISON( Value )
+variant_EXTERN_INSTANTIATE_VISIT( length, Value )
+variant_EXTERN_INSTANTIATE( Key )
+variant_EXTERN_INSTANTIATE_HASH( Key )
+
+CASE( "instantiate: Allows to explicitly instantiate construction, assignment and destruction (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    Value a = std::string( "abc" );
+    Value b = std::vector<int>( 2, 7 );
+    Value c = a;
+
+    EXPECT( nonstd::get<std::string>( c ) == "abc" );
+
+    c = b;
+    EXPECT( nonstd::get<2>( c ).size() == 2u );
+
+    c = std::move( a );
+    EXPECT( nonstd::get<std::string>( c ) == "abc" );
+
+    Value d( std::move( c ) );
+    d.swap( b );
+    EXPECT( b.index() == 1u );
+    EXPECT( d.index() == 2u );
+#else
+    EXPECT( !!"instantiate: not available (no C++11)" );
+#endif
+}
+
+CASE( "instantiate: Allows to explicitly instantiate comparison, hashing and visitation (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    Value const a = std::string( "abc" );
+    Value const b = std::string( "abd" );
+    Key   const k = std::string( "key" );
+
+    EXPECT( ( a == a ) );
+    EXPECT( ( a <  b ) );
+    EXPECT( ( a != b ) );
+    EXPECT( nonstd::visit( length(), a ) == 3u );
+    EXPECT( std::hash<Key>()( k ) == std::hash<Key>()( Key( std::string( "key" ) ) ) );
+#else
+    EXPECT( !!"instantiate: not available (no C++11)" );
+#endif
+}
+
+variant_INSTANTIATE( Value )
+variant_INSTANTIATE_COMPARISON( Value )
+variant_INSTANTIATE_VISIT( length, Value )
+variant_INSTANTIATE( Key )
+variant_INSTANTIATE_HASH( Key )
+
+// end of file
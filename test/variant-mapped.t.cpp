@@ -0,0 +1,158 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "variant-main.t.hpp"
+#include "nonstd/variant_mapped.hpp"
+
+#include <vector>
+
+#if variant_CPP11_OR_GREATER
+
+namespace {
+
+struct Point
+{
+    int x, y;
+};
+
+inline bool operator==( Point const & a, Point const & b )
+{
+    return a.x == b.x && a.y == b.y;
+}
+
+struct Size
+{
+    int w, h;
+};
+
+typedef nonstd::variant< int, double, Point > var_t;
+
+// storage with the alignment the mapped layout requires, as mmap() provides:
+
+struct mapping
+{
+    std::vector< std::uint64_t > words;
+
+    explicit mapping( std::size_t size )
+        : words( ( size + sizeof( std::uint64_t ) - 1 ) / sizeof( std::uint64_t ) ) {}
+
+    char * data()
+    {
+        return reinterpret_cast<char *>( words.data() );
+    }
+};
+
+struct sum_visitor
+{
+    double operator()( int x ) const { return x; }
+    double operator()( double x ) const { return x; }
+    double operator()( Point const & p ) const { return p.x + p.y; }
+};
+
+} // anonymous namespace
+
+namespace nonstd {
+
+template<>
+struct variant_mapped_tag< Size > : std::integral_constant< std::uint64_t, 1 > {};
+
+} // namespace nonstd
+
+#endif // variant_CPP11_OR_GREATER
+
+CASE( "mapped: Allows to write variants and to access them in place (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    std::vector< var_t > const in = { 1, 2.5, Point{ 3, 4 }, 5 };
+
+    mapping map( nonstd::mapped_size< var_t >( in.size() ) );
+
+    char * end = nonstd::write_mapped( in.begin(), in.end(), map.data() );
+
+    EXPECT( end == map.data() + nonstd::mapped_size< var_t >( in.size() ) );
+
+    nonstd::mapped_variant_span< var_t > span( map.data(), nonstd::mapped_size< var_t >( in.size() ) );
+
+    EXPECT( span.valid() );
+    EXPECT( span.size() == in.size() );
+    EXPECT( span.index( 2 ) == 2u );
+
+    EXPECT(   1 == *span.get_if< 0 >( 0 ) );
+    EXPECT( 2.5 == *span.get_if< double >( 1 ) );
+    EXPECT(   3 == span.get_if< Point >( 2 )->x );
+    EXPECT( ( nullptr == span.get_if< int >( 1 ) ) );
+
+    EXPECT( 7.0 == span.visit( 2, sum_visitor() ) );
+    EXPECT( ( span[0] == in[0] ) );
+    EXPECT( ( span[1] == in[1] ) );
+#else
+    EXPECT( !!"mapped: not available (no C++11)" );
+#endif
+}
+
+CASE( "mapped: Allows to map an empty sequence (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    std::vector< var_t > const in;
+
+    mapping map( nonstd::mapped_size< var_t >( 0 ) );
+
+    nonstd::write_mapped( in.begin(), in.end(), map.data() );
+
+    nonstd::mapped_variant_span< var_t > span( map.data(), nonstd::mapped_size< var_t >( 0 ) );
+
+    EXPECT( span.valid() );
+    EXPECT( span.empty() );
+#else
+    EXPECT( !!"mapped: not available (no C++11)" );
+#endif
+}
+
+CASE( "mapped: Rejects data written for another alternative set (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, double, Size > other_t;
+
+    std::vector< var_t > const in = { 1, 2.5 };
+
+    mapping map( nonstd::mapped_size< var_t >( in.size() ) );
+
+    nonstd::write_mapped( in.begin(), in.end(), map.data() );
+
+    EXPECT( nonstd::variant_fingerprint< var_t >::value != nonstd::variant_fingerprint< other_t >::value );
+    EXPECT_NOT( ( nonstd::mapped_variant_span< other_t >( map.data(), nonstd::mapped_size< var_t >( in.size() ) ).valid() ) );
+#else
+    EXPECT( !!"mapped: not available (no C++11)" );
+#endif
+}
+
+CASE( "mapped: Rejects truncated, misaligned or corrupted data (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::mapped_variant_span< var_t > span_t;
+
+    std::vector< var_t > const in = { 1, 2.5 };
+    std::size_t const size = nonstd::mapped_size< var_t >( in.size() );
+
+    mapping map( size + 8 );
+
+    nonstd::write_mapped( in.begin(), in.end(), map.data() );
+
+    EXPECT(     span_t( map.data(), size     ).valid()   );
+    EXPECT_NOT( span_t( map.data(), size - 1 ).valid()   );
+    EXPECT_NOT( span_t( map.data(), 10       ).valid()   );
+    EXPECT_NOT( span_t( map.data() + 1, size ).valid()   );
+
+    map.data()[ nonstd::mapped_variant_layout< var_t >::index_offset ] = 7;
+
+    EXPECT_NOT( span_t( map.data(), size ).valid() );
+#else
+    EXPECT( !!"mapped: not available (no C++11)" );
+#endif
+}
+
+// end of file
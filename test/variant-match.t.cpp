@@ -0,0 +1,139 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "variant-main.t.hpp"
+#include "nonstd/variant_match.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+namespace {
+
+struct circle { int r; };
+struct square { int a; };
+struct empty  {};
+
+typedef nonstd::variant< circle, square, empty > shape_t;
+
+int empty_area( empty const & ) { return 0; }
+
+struct area
+{
+    int operator()( circle const & c ) const { return 3 * c.r * c.r; }
+    int operator()( square const & s ) const { return s.a * s.a; }
+    int operator()( empty  const & e ) const { return empty_area( e ); }
+};
+
+struct round_only
+{
+    int operator()( circle const & ) const { return 1; }
+    int operator()( square const & ) const { return 0; }
+};
+
+} // anonymous namespace
+
+#endif // variant_CPP11_OR_GREATER
+
+CASE( "match: Allows to call the handler for the active alternative (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    shape_t s = square{ 3 };
+
+    int result = nonstd::match( s,
+        []( circle const & c ) { return c.r; },
+        []( square const & q ) { return q.a; },
+        empty_area );
+
+    EXPECT( result == 3 );
+    EXPECT( nonstd::match( shape_t( circle{ 2 } ), area() ) == 12 );
+#else
+    EXPECT( !!"match: not available (no C++11)" );
+#endif
+}
+
+CASE( "match: Allows to modify and to move from the active alternative (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    nonstd::variant< int, std::string > v = std::string( "hello" );
+
+    nonstd::match( v,
+        []( int & i ) { ++i; },
+        []( std::string & s ) { s += " world"; } );
+
+    std::string moved = nonstd::match( std::move( v ),
+        []( int && ) { return std::string(); },
+        []( std::string && s ) { return std::move( s ); } );
+
+    EXPECT( moved == "hello world" );
+#else
+    EXPECT( !!"match: not available (no C++11)" );
+#endif
+}
+
+CASE( "match: Allows to combine handlers and function pointers via overload() (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    auto handlers = nonstd::overload(
+        []( circle const & ) { return 'c'; },
+        []( square const & ) { return 's'; },
+        []( empty  const & ) { return 'e'; } );
+
+    auto copy = handlers;
+
+    EXPECT( copy( square{ 1 } ) == 's' );
+    EXPECT( nonstd::overload( empty_area, []( int i ) { return i; } )( 7 ) == 7 );
+    EXPECT( nonstd::match( shape_t( empty() ), copy ) == 'e' );
+#else
+    EXPECT( !!"match: not available (no C++11)" );
+#endif
+}
+
+CASE( "match: Allows a generic handler to handle the remaining alternatives (C++14)" )
+{
+#if variant_CPP14_OR_GREATER
+    shape_t s = empty();
+
+    int result = nonstd::match( s,
+        []( circle const & ) { return 1; },
+        []( auto const & ) { return 2; } );
+
+    EXPECT( result == 2 );
+#else
+    EXPECT( !!"match: not available (no C++14)" );
+#endif
+}
+
+CASE( "match: Allows to test for a likely alternative first via match_likely() and visit_likely() (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    shape_t likely   = circle{ 2 };
+    shape_t unlikely = square{ 3 };
+
+    EXPECT( nonstd::match_likely< circle >( likely  , area() ) == 12 );
+    EXPECT( nonstd::match_likely< circle >( unlikely, area() ) ==  9 );
+    EXPECT( nonstd::visit_likely< square >( area(), likely   ) == 12 );
+    EXPECT( nonstd::visit_likely< square >( area(), unlikely ) ==  9 );
+#else
+    EXPECT( !!"match: not available (no C++11)" );
+#endif
+}
+
+CASE( "match: Requires a handler for every alternative (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    using nonstd::variants::detail::is_handled;
+    using nonstd::variants::detail::match_exhaustive;
+    using nonstd::variants::detail::make_index_list;
+
+    EXPECT( ( match_exhaustive< area, shape_t const &, make_index_list< 3 >::type >::value ) );
+    EXPECT( ( is_handled< round_only, circle const & >::value ) );
+    EXPECT( ( is_handled< round_only, empty  const & >::value == false ) );
+#else
+    EXPECT( !!"match: not available (no C++11)" );
+#endif
+}
+
+// end of file
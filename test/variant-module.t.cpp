@@ -0,0 +1,86 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Test of module nonstd.variant: the names of nonstd/variant.hpp, including the
+// non-standard ones, are available via import. Without lest, as its header
+// includes nonstd/variant.hpp. GCC 12 requires the standard headers before the
+// import and miscompiles std::vector next to it, hence the plain array.
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <iterator>
+#include <new>
+
+import nonstd.variant;
+
+namespace {
+
+int failures = 0;
+
+void expect( bool ok, char const * expression )
+{
+    if ( ! ok )
+    {
+        ++failures;
+        std::cerr << "variant-module.t.cpp: failed: " << expression << "\n";
+    }
+}
+
+#define EXPECT( expr )  expect( expr, #expr )
+
+typedef nonstd::variant< int, char, double > var_t;
+
+struct index_of
+{
+    std::size_t operator()( int    ) const { return 0; }
+    std::size_t operator()( char   ) const { return 1; }
+    std::size_t operator()( double ) const { return 2; }
+};
+
+} // anonymous namespace
+
+int main()
+{
+    var_t v[] = { var_t( 'a' ), var_t( 1 ), var_t( 2.5 ), var_t( 2 ) };
+
+    // standard interface:
+
+    EXPECT( nonstd::holds_alternative< char >( v[0] ) );
+    EXPECT( nonstd::get< int >( v[1] ) == 1 );
+    EXPECT( nonstd::get_if< 2 >( &v[2] ) != nullptr );
+    EXPECT( nonstd::visit( index_of(), v[2] ) == 2u );
+    EXPECT( nonstd::variant_size< var_t >::value == 3u );
+    EXPECT( v[1] < v[3] );
+
+    // non-standard interface:
+
+    EXPECT( ( nonstd::holds_any_of< int, char >( v[0] ) ) );
+    EXPECT( ( ! nonstd::holds_any_of< int, char >( v[2] ) ) );
+    EXPECT( std::count_if( std::begin( v ), std::end( v ), nonstd::alternative_set< int, double >() ) == 3 );
+
+    EXPECT( nonstd::count_alternative< int >( std::begin( v ), std::end( v ) ) == 2u );
+    EXPECT( nonstd::count_alternative< int >( v ) == 2u );
+    EXPECT( nonstd::find_alternative< double >( std::begin( v ), std::end( v ) ) == v + 2 );
+
+    std::array< std::size_t, 3 > counts = {};
+    nonstd::index_histogram( std::begin( v ), std::end( v ), counts.begin() );
+
+    EXPECT( ( counts == std::array< std::size_t, 3 >{ 2, 1, 1 } ) );
+    EXPECT( ( nonstd::index_histogram( v ) == std::array< std::size_t, 3 >{ 2, 1, 1 } ) );
+
+    var_t const * const mid = nonstd::partition_by_index( std::begin( v ), std::end( v ), 0 );
+
+    EXPECT( mid - v == 2 );
+    EXPECT( nonstd::holds_alternative< int >( v[0] ) && nonstd::holds_alternative< int >( v[1] ) );
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// end of file
@@ -0,0 +1,105 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "variant-main.t.hpp"
+#include "nonstd/variant_profile.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+#include <sstream>
+
+namespace {
+
+struct profiled_a { int v; };
+struct profiled_b { int v; };
+
+typedef nonstd::variant< profiled_a, profiled_b > profiled_t;
+
+struct profiled_value
+{
+    int operator()( profiled_a const & a ) const { return a.v; }
+    int operator()( profiled_b const & b ) const { return b.v; }
+};
+
+nonstd::variant_statistics make_statistics()
+{
+    nonstd::variant_alternative_stats const a = { 1, 2, 3, 4, 5, 6 };
+    nonstd::variant_alternative_stats const b = { 0, 0, 0, 0, 7, 0 };
+
+    nonstd::variant_statistics stats = { true, "v", std::vector< nonstd::variant_alternative_stats >() };
+    stats.alternatives.push_back( a );
+    stats.alternatives.push_back( b );
+    return stats;
+}
+
+} // anonymous namespace
+
+#endif // variant_CPP11_OR_GREATER
+
+CASE( "profile: Allows to obtain the counts of operations per alternative (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    nonstd::variant_statistics const before = nonstd::variant_stats< profiled_t >();
+
+    profiled_t v = profiled_a{ 1 };
+    profiled_t w = v;
+
+    v.emplace< profiled_b >( profiled_b{ 2 } );
+    w = std::move( v );
+
+    EXPECT( nonstd::visit( profiled_value(), w ) == 2 );
+
+    nonstd::variant_statistics const after = nonstd::variant_stats< profiled_t >();
+
+    EXPECT( after.alternatives.size() == 2u );
+
+# if variant_USES_PROFILE
+    EXPECT( after.enabled );
+    EXPECT( after.alternatives[0].constructions - before.alternatives[0].constructions == 1u );
+    EXPECT( after.alternatives[0].copies        - before.alternatives[0].copies        == 1u );
+    EXPECT( after.alternatives[1].emplaces      - before.alternatives[1].emplaces      == 1u );
+    EXPECT( after.alternatives[1].moves         - before.alternatives[1].moves         == 1u );
+    EXPECT( after.alternatives[1].visits        - before.alternatives[1].visits        == 1u );
+# else
+    EXPECT_NOT( after.enabled );
+    EXPECT( after.total().visits == 0u );
+# endif
+#else
+    EXPECT( !!"profile: not available (no C++11)" );
+#endif
+}
+
+CASE( "profile: Allows to write statistics as CSV and as JSON (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    std::vector< nonstd::variant_statistics > const stats( 1, make_statistics() );
+
+    std::ostringstream csv;
+    std::ostringstream json;
+
+    nonstd::write_variant_stats_csv ( csv , stats );
+    nonstd::write_variant_stats_json( json, stats );
+
+    EXPECT( csv.str() ==
+        "variant,index,constructions,copies,moves,emplaces,visits,bad_accesses\n"
+        "\"v\",0,1,2,3,4,5,6\n"
+        "\"v\",1,0,0,0,0,7,0\n" );
+
+    EXPECT( json.str() ==
+        "[\n"
+        " {\"variant\":\"v\",\"alternatives\":["
+        "{\"index\":0,\"constructions\":1,\"copies\":2,\"moves\":3,\"emplaces\":4,\"visits\":5,\"bad_accesses\":6},"
+        "{\"index\":1,\"constructions\":0,\"copies\":0,\"moves\":0,\"emplaces\":0,\"visits\":7,\"bad_accesses\":0}]}\n"
+        "]\n" );
+
+    EXPECT( stats[0].total().visits == 12u );
+#else
+    EXPECT( !!"profile: not available (no C++11)" );
+#endif
+}
+
+// end of file
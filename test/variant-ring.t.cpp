@@ -0,0 +1,146 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "variant-main.t.hpp"
+#include "nonstd/variant_ring.hpp"
+
+#include <string>
+
+#if variant_CPP11_OR_GREATER
+
+namespace {
+
+// count constructions, copies, moves and destructions:
+
+struct Tracked
+{
+    static int constructed;
+    static int copied;
+    static int moved;
+    static int destroyed;
+
+    static void reset() { constructed = copied = moved = destroyed = 0; }
+
+    int value;
+
+    Tracked( int v ) : value( v ) { ++constructed; }
+    Tracked( Tracked const & other ) : value( other.value ) { ++copied; }
+    Tracked( Tracked && other ) : value( other.value ) { ++moved; }
+    ~Tracked() { ++destroyed; }
+};
+
+int Tracked::constructed = 0;
+int Tracked::copied      = 0;
+int Tracked::moved       = 0;
+int Tracked::destroyed   = 0;
+
+typedef nonstd::variant< int, std::string, Tracked > msg_t;
+
+struct sum
+{
+    int & total;
+
+    void operator()( int x ) const { total += x; }
+    void operator()( std::string const & s ) const { total += static_cast<int>( s.size() ); }
+    void operator()( Tracked const & t ) const { total += t.value; }
+};
+
+template< class Ring >
+void fill_and_drain( lest::env & lest_env )
+{
+    Ring ring;
+    int total = 0;
+
+    EXPECT( ring.empty() );
+    EXPECT( ring.template try_emplace<0>( 1 ) );
+    EXPECT( ring.template try_emplace<std::string>( "abc" ) );
+    EXPECT( ring.template try_emplace<Tracked>( 10 ) );
+    EXPECT( ring.template try_emplace<0>( 100 ) );
+    EXPECT_NOT( ring.template try_emplace<0>( 1000 ) );
+    EXPECT( ring.size() == 4u );
+
+    EXPECT( ring.try_consume( sum{ total } ) );
+    EXPECT( total == 1 );
+
+    EXPECT( ring.consume_batch( sum{ total } ) == 3u );
+    EXPECT( total == 114 );
+
+    EXPECT_NOT( ring.try_consume( sum{ total } ) );
+    EXPECT( ring.empty() );
+}
+
+} // anonymous namespace
+
+#endif // variant_CPP11_OR_GREATER
+
+CASE( "variant_ring: Allows to emplace and to consume variants, single producer and consumer (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    fill_and_drain< nonstd::variant_ring< msg_t, 4 > >( lest_env );
+#else
+    EXPECT( !!"variant_ring: not available (no C++11)" );
+#endif
+}
+
+CASE( "variant_ring: Allows to emplace and to consume variants, multiple producers and consumers (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    fill_and_drain< nonstd::variant_ring< msg_t, 4, nonstd::ring_mpmc > >( lest_env );
+#else
+    EXPECT( !!"variant_ring: not available (no C++11)" );
+#endif
+}
+
+CASE( "variant_ring: Constructs and destroys each message once, without copy or move (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    Tracked::reset();
+    {
+        nonstd::variant_ring< msg_t, 8 > spsc;
+        nonstd::variant_ring< msg_t, 8, nonstd::ring_mpmc > mpmc;
+        int total = 0;
+
+        spsc.try_emplace<Tracked>( 1 );
+        spsc.try_emplace<Tracked>( 2 );
+        mpmc.try_emplace<Tracked>( 3 );
+        mpmc.try_emplace<Tracked>( 4 );
+
+        spsc.try_consume( sum{ total } );
+        mpmc.try_consume( sum{ total } );
+
+        EXPECT( total == 4 );
+        EXPECT( Tracked::destroyed == 2 );
+    }
+    EXPECT( Tracked::constructed == 4 );
+    EXPECT( Tracked::copied      == 0 );
+    EXPECT( Tracked::moved       == 0 );
+    EXPECT( Tracked::destroyed   == 4 );
+#else
+    EXPECT( !!"variant_ring: not available (no C++11)" );
+#endif
+}
+
+CASE( "variant_ring: Allows to consume a limited batch (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    nonstd::variant_ring< msg_t, 8 > ring;
+    int total = 0;
+
+    for ( int i = 1; i <= 5; ++i )
+    {
+        ring.try_emplace<0>( i );
+    }
+
+    EXPECT( ring.consume_batch( sum{ total }, 2 ) == 2u );
+    EXPECT( total == 3 );
+    EXPECT( ring.size() == 3u );
+#else
+    EXPECT( !!"variant_ring: not available (no C++11)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,112 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "variant-main.t.hpp"
+#include "nonstd/variant_seqlock.hpp"
+
+#if variant_CPP11_OR_GREATER
+
+namespace {
+
+struct Quote
+{
+    double bid, ask;
+    long long bid_size, ask_size;
+};
+
+struct Config
+{
+    int values[16];
+
+    Config( int value )
+    {
+        for ( int & v : values ) v = value;
+    }
+};
+
+typedef nonstd::variant< int, Quote, Config > var_t;
+
+struct total
+{
+    double operator()( int x ) const { return x; }
+    double operator()( Quote const & q ) const { return q.bid + q.ask; }
+    double operator()( Config const & c ) const { return c.values[0] + c.values[15]; }
+};
+
+struct store_total
+{
+    double & result;
+
+    template< class T >
+    void operator()( T const & x ) const { result = total()( x ); }
+};
+
+} // anonymous namespace
+
+#endif // variant_CPP11_OR_GREATER
+
+CASE( "seqlock_variant: Allows to store and load a variant (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    nonstd::seqlock_variant< var_t > sv;
+
+    EXPECT( sv.index() == 0u );
+    EXPECT( sv.version() == 0u );
+
+    sv.store( Quote{ 1.5, 2.5, 10, 20 } );
+
+    EXPECT( sv.index() == 1u );
+    EXPECT( nonstd::get<Quote>( sv.load() ).ask_size == 20 );
+    EXPECT( sv.version() == 1u );
+
+    sv = var_t( 7 );
+
+    EXPECT( nonstd::get<int>( sv.load() ) == 7 );
+#else
+    EXPECT( !!"seqlock_variant: not available (no C++11)" );
+#endif
+}
+
+CASE( "seqlock_variant: Allows to emplace an alternative (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    nonstd::seqlock_variant< var_t > sv;
+
+    sv.emplace< 2 >( 3 );
+
+    EXPECT( nonstd::get<Config>( sv.load() ).values[15] == 3 );
+
+    sv.emplace< Config >( 4 );
+
+    EXPECT( nonstd::get<Config>( sv.load() ).values[0] == 4 );
+#else
+    EXPECT( !!"seqlock_variant: not available (no C++11)" );
+#endif
+}
+
+CASE( "seqlock_variant: Allows to visit and to try to visit the current value (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    nonstd::seqlock_variant< var_t > sv( var_t( Quote{ 1.5, 2.5, 10, 20 } ) );
+
+    EXPECT( sv.visit( total() ) == 4.0 );
+
+    double result = 0;
+
+    EXPECT( sv.try_visit( store_total{ result } ) );
+    EXPECT( result == 4.0 );
+
+    var_t v;
+
+    EXPECT( sv.try_load( v ) );
+    EXPECT( nonstd::get<Quote>( v ).bid_size == 10 );
+#else
+    EXPECT( !!"seqlock_variant: not available (no C++11)" );
+#endif
+}
+
+// end of file
@@ -0,0 +1,400 @@
+// Copyright 2016-2025 by Martin Moene
+//
+// https://github.com/martinmoene/variant-lite
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "variant-main.t.hpp"
+#include "nonstd/variant_serialize.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <vector>
+
+#if variant_CPP11_OR_GREATER
+
+namespace {
+
+struct Point
+{
+    int x, y;
+};
+
+struct NoDefault
+{
+    NoDefault( int v ) : value( v ) {}
+    int value;
+};
+
+// user-provided codec for a type that is not trivially copyable:
+
+struct Name
+{
+    std::string text;
+    int decoded_from_bytes = 0;
+
+    Name( std::string text_ ) : text( text_ ) {}
+    Name( char const * first, std::size_t length ) : text( first, length ), decoded_from_bytes( 1 ) {}
+};
+
+} // anonymous namespace
+
+namespace nonstd {
+
+template<>
+struct variant_codec< Name >
+{
+    static std::size_t size( Name const & name )
+    {
+        return 1 + name.text.size();
+    }
+
+    static char * encode( Name const & name, char * out )
+    {
+        *out++ = static_cast<char>( name.text.size() );
+        return std::copy( name.text.begin(), name.text.end(), out );
+    }
+
+    template< class Emplace >
+    static char const * decode( char const * first, char const * last, Emplace & emplace )
+    {
+        if ( first == last )
+            return nullptr;
+
+        std::size_t const length = static_cast<unsigned char>( *first++ );
+
+        if ( length > static_cast<std::size_t>( last - first ) )
+            return nullptr;
+
+        emplace( first, length );
+        return first + length;
+    }
+};
+
+} // namespace nonstd
+
+namespace {
+
+template< class V >
+V round_trip( V const & v )
+{
+    std::vector<char> buffer( nonstd::serialized_size( v ) );
+
+    char * end = nonstd::serialize( v, buffer.data() );
+
+    V result;
+    char const * pos = nonstd::deserialize( buffer.data(), end, result );
+
+    return pos == end ? result : V();
+}
+
+template< class V >
+std::vector<char> serialize_all( std::vector<V> const & in )
+{
+    std::vector<char> buffer;
+
+    for ( auto const & v : in )
+    {
+        std::size_t const offset = buffer.size();
+
+        buffer.resize( offset + nonstd::serialized_size( v ) );
+        nonstd::serialize( v, buffer.data() + offset );
+    }
+    return buffer;
+}
+
+// feed buffer to decoder in fragments of the given size:
+
+template< class Decoder, class V >
+void decode_fragments( Decoder & decoder, std::vector<char> const & buffer, std::size_t fragment, std::vector<V> & out )
+{
+    for ( std::size_t pos = 0; pos < buffer.size(); pos += fragment )
+    {
+        std::size_t const n = ( std::min )( fragment, buffer.size() - pos );
+
+        decoder.decode_many( buffer.data() + pos, buffer.data() + pos + n, std::back_inserter( out ) );
+    }
+}
+
+} // anonymous namespace
+
+#endif // variant_CPP11_OR_GREATER
+
+CASE( "serialize: Allows to serialize and deserialize trivially copyable alternatives (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< nonstd::monostate, int, double, Point > var_t;
+
+    EXPECT( 1u == nonstd::serialized_size( var_t() ) );
+    EXPECT( 1u + sizeof(int) == nonstd::serialized_size( var_t( 7 ) ) );
+
+    EXPECT( 0u == round_trip( var_t() ).index() );
+    EXPECT( 7 == nonstd::get<int>( round_trip( var_t( 7 ) ) ) );
+    EXPECT( 0.5 == nonstd::get<double>( round_trip( var_t( 0.5 ) ) ) );
+
+    Point const p = nonstd::get<Point>( round_trip( var_t( Point{ 3, 4 } ) ) );
+
+    EXPECT( 3 == p.x );
+    EXPECT( 4 == p.y );
+#else
+    EXPECT( !!"serialize: not available (no C++11)" );
+#endif
+}
+
+CASE( "serialize: Allows to deserialize alternatives that are not default constructible (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, NoDefault > var_t;
+
+    EXPECT( 42 == nonstd::get<NoDefault>( round_trip( var_t( nonstd::in_place_index<1>, 42 ) ) ).value );
+#else
+    EXPECT( !!"serialize: not available (no C++11)" );
+#endif
+}
+
+CASE( "serialize: Allows to serialize and deserialize strings (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, std::string, std::wstring > var_t;
+
+    EXPECT( "hello" == nonstd::get<std::string>( round_trip( var_t( std::string( "hello" ) ) ) ) );
+    EXPECT( ( L"world" == nonstd::get<std::wstring>( round_trip( var_t( std::wstring( L"world" ) ) ) ) ) );
+    EXPECT( ""      == nonstd::get<std::string>( round_trip( var_t( std::string() ) ) ) );
+#else
+    EXPECT( !!"serialize: not available (no C++11)" );
+#endif
+}
+
+CASE( "serialize: Allows to provide a codec that constructs the alternative in place (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, Name > var_t;
+
+    var_t const v = round_trip( var_t( Name( "name" ) ) );
+
+    EXPECT( "name" == nonstd::get<Name>( v ).text );
+    EXPECT(      1 == nonstd::get<Name>( v ).decoded_from_bytes );
+#else
+    EXPECT( !!"serialize: not available (no C++11)" );
+#endif
+}
+
+CASE( "serialize: Reports malformed or truncated input (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, std::string > var_t;
+
+    var_t v;
+    char const bad_index[] = { 5 };
+    char const truncated[] = { 0, 1, 2 };
+    char const long_str [] = { 1, 9, 'a', 'b' };
+
+    EXPECT( ( nullptr == nonstd::deserialize( bad_index, bad_index + 1, v ) ) );
+    EXPECT( ( nullptr == nonstd::deserialize( truncated, truncated + 3, v ) ) );
+    EXPECT( ( nullptr == nonstd::deserialize( long_str , long_str  + 4, v ) ) );
+    EXPECT( ( nullptr == nonstd::deserialize( bad_index, bad_index    , v ) ) );
+#else
+    EXPECT( !!"serialize: not available (no C++11)" );
+#endif
+}
+
+CASE( "serialize: Rejects a varint that overflows std::size_t (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, std::string > var_t;
+
+    // zero groups of bits up to the last group, which only has bits beyond std::size_t;
+    // dropping those would decode index 0 with an int payload and an empty string:
+
+    std::vector< char > overflow( std::numeric_limits< std::size_t >::digits / 7, '\x80' );
+    overflow.push_back( '\x40' );
+
+    std::vector< char > length( 1, '\x01' );
+    length.insert( length.end(), overflow.begin(), overflow.end() );
+
+    overflow.insert( overflow.end(), sizeof( int ), '\0' );
+
+    var_t v;
+
+    EXPECT( ( nullptr == nonstd::deserialize( overflow.data(), overflow.data() + overflow.size(), v ) ) );
+    EXPECT( ( nullptr == nonstd::deserialize( length.data()  , length.data()   + length.size()  , v ) ) );
+
+    nonstd::variant_decoder< var_t > decoder;
+    std::vector< var_t > out;
+
+    decoder.decode_many( overflow.data(), overflow.data() + overflow.size(), std::back_inserter( out ) );
+
+    EXPECT( decoder.failed() );
+#else
+    EXPECT( !!"serialize: not available (no C++11)" );
+#endif
+}
+
+CASE( "serialize: Rejects a varint that is not minimally encoded (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, std::string > var_t;
+
+    // index 0 as 0x80 0x00 and string length 3 as 0x83 0x00:
+
+    std::vector< char > index = { '\x80', '\x00', '\x00', '\x00', '\x00', '\x00' };
+    std::vector< char > length = { '\x01', '\x83', '\x00', 'a', 'b', 'c' };
+
+    var_t v;
+
+    EXPECT( ( nullptr == nonstd::deserialize( index.data() , index.data()  + index.size() , v ) ) );
+    EXPECT( ( nullptr == nonstd::deserialize( length.data(), length.data() + length.size(), v ) ) );
+
+    nonstd::variant_decoder< var_t > decoder;
+    std::vector< var_t > out;
+
+    decoder.decode_many( index.data(), index.data() + index.size(), std::back_inserter( out ) );
+
+    EXPECT( decoder.failed() );
+    EXPECT( out.empty() );
+#else
+    EXPECT( !!"serialize: not available (no C++11)" );
+#endif
+}
+
+CASE( "serialize: Allows to serialize and deserialize a sequence of variants (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, double, std::string > var_t;
+
+    std::vector< var_t > const in = { 1, 2.5, std::string( "three" ), 4 };
+    std::vector< var_t > out;
+    std::vector< char > buffer( nonstd::serialized_range_size( in.begin(), in.end() ) );
+
+    char * end = nonstd::serialize_range( in.begin(), in.end(), buffer.data() );
+
+    EXPECT( ( end == buffer.data() + buffer.size() ) );
+    EXPECT( ( end == nonstd::deserialize_range( buffer.data(), end, out ) ) );
+    EXPECT( ( out == in ) );
+
+    EXPECT( ( nullptr == nonstd::deserialize_range( buffer.data(), end - 1, out ) ) );
+    EXPECT( 4u + 3u == out.size() );
+#else
+    EXPECT( !!"serialize: not available (no C++11)" );
+#endif
+}
+
+CASE( "decoder: Allows to decode a stream of variants that arrives in fragments (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< nonstd::monostate, int, double, std::string, NoDefault > var_t;
+
+    std::vector< var_t > const in = { 1, var_t(), std::string( 200, 'x' ), 2.5, std::string(), var_t( nonstd::in_place_index<4>, 7 ), 3 };
+    std::vector< char > const buffer = serialize_all( in );
+
+    for ( std::size_t fragment : { std::size_t( 1 ), std::size_t( 3 ), std::size_t( 64 ), buffer.size() } )
+    {
+        nonstd::variant_decoder< var_t > decoder;
+        std::vector< var_t > out;
+
+        decode_fragments( decoder, buffer, fragment, out );
+
+        EXPECT( decoder.idle() );
+        EXPECT_NOT( decoder.failed() );
+        EXPECT( out.size() == in.size() );
+
+        for ( std::size_t i = 0; i != (std::min)( in.size(), out.size() ); ++i )
+        {
+            EXPECT( out[i].index() == in[i].index() );
+        }
+
+        EXPECT( 200u == nonstd::get<std::string>( out[2] ).size() );
+        EXPECT(    7 == nonstd::get<NoDefault>( out[5] ).value );
+        EXPECT(    3 == nonstd::get<int>( out[6] ) );
+    }
+#else
+    EXPECT( !!"decoder: not available (no C++11)" );
+#endif
+}
+
+CASE( "decoder: Allows to receive each variant via a callback (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, std::string > var_t;
+
+    std::vector< char > const buffer = serialize_all( std::vector< var_t >{ 1, std::string( "two" ), 3 } );
+
+    nonstd::variant_decoder< var_t > decoder;
+    int sum = 0;
+
+    std::size_t const count = decoder.decode( buffer.data(), buffer.data() + buffer.size() - 1, [&sum]( var_t & v )
+    {
+        sum += v.index() == 0 ? nonstd::get<int>( v ) : static_cast<int>( nonstd::get<std::string>( v ).size() );
+    } );
+
+    EXPECT( count == 2u );
+    EXPECT( sum   == 4  );
+    EXPECT_NOT( decoder.idle() );
+#else
+    EXPECT( !!"decoder: not available (no C++11)" );
+#endif
+}
+
+CASE( "decoder: Reports malformed input until reset (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, std::string > var_t;
+
+    nonstd::variant_decoder< var_t > decoder;
+    std::vector< var_t > out;
+
+    char const bad_index[] = { 5 };
+    std::vector< char > const good = serialize_all( std::vector< var_t >{ 1 } );
+
+    decoder.decode_many( bad_index, bad_index + 1, std::back_inserter( out ) );
+    decoder.decode_many( good.data(), good.data() + good.size(), std::back_inserter( out ) );
+
+    EXPECT( decoder.failed() );
+    EXPECT( out.empty() );
+
+    decoder.reset();
+    decoder.decode_many( good.data(), good.data() + good.size(), std::back_inserter( out ) );
+
+    EXPECT_NOT( decoder.failed() );
+    EXPECT( out.size() == 1u );
+#else
+    EXPECT( !!"decoder: not available (no C++11)" );
+#endif
+}
+
+CASE( "decoder: Reports a payload larger than the maximum payload size as malformed (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef nonstd::variant< int, std::string > var_t;
+
+    std::vector< char > const fits = serialize_all( std::vector< var_t >{ std::string( 16, 'x' ) } );
+    std::vector< char > const huge = serialize_all( std::vector< var_t >{ std::string( 1000, 'x' ) } );
+
+    for ( std::size_t fragment : { std::size_t( 1 ), std::size_t( 2 ), huge.size() } )
+    {
+        nonstd::variant_decoder< var_t > decoder( 32 );
+        std::vector< var_t > out;
+
+        decode_fragments( decoder, fits, fragment, out );
+
+        EXPECT_NOT( decoder.failed() );
+        EXPECT( out.size() == 1u );
+
+        // a header that announces 1000 characters suffices to fail:
+
+        decode_fragments( decoder, std::vector< char >( huge.begin(), huge.begin() + 3 ), fragment, out );
+
+        EXPECT( decoder.failed() );
+        EXPECT( out.size() == 1u );
+    }
+
+    EXPECT( nonstd::variant_decoder< var_t >().max_payload() == nonstd::variant_decoder< var_t >::default_max_payload );
+#else
+    EXPECT( !!"decoder: not available (no C++11)" );
+#endif
+}
+
+// end of file
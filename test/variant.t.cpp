@@ -6,9 +6,12 @@
 // (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include "variant-main.t.hpp"
+#include "nonstd/variant_util.hpp"
 
+#include <algorithm>
 #include <map>
 #include <memory>
+#include <vector>
 
 using namespace nonstd;
 
@@ -627,12 +630,7 @@ CASE( "variant: Allows to move-assign from element value" )
 
         EXPECT( get<S>(var).value.value == 7 );
         EXPECT( get<S>(var).value.state == move_constructed );
-        EXPECT( get<S>(var).value.state == move_constructed );
-#if variant_USES_STD_VARIANT
         EXPECT( get<S>(var).state       == value_move_constructed );
-#else
-        EXPECT( get<S>(var).state       == move_constructed );
-#endif
     }
     }
 #else
@@ -1331,6 +1329,41 @@ CASE( "variant: Allows to check for content by type" )
 #endif
 }
 
+CASE( "variant: Allows to check for content by any of several types (non-standard, C++11)" )
+{
+#if variant_CPP11_OR_GREATER && ! variant_USES_STD_VARIANT
+    typedef variant< int, long, double, std::string > var_t;
+    var_t vi = 7;
+    var_t vd = 7.0;
+    var_t vs = std::string("hello");
+
+    EXPECT(     ( holds_any_of< int, double      >( vi ) ) );
+    EXPECT(     ( holds_any_of< int, double      >( vd ) ) );
+    EXPECT_NOT( ( holds_any_of< int, double      >( vs ) ) );
+    EXPECT(     ( holds_any_of< std::string      >( vs ) ) );
+    EXPECT_NOT( ( holds_any_of<                  >( vi ) ) );
+
+    empty_variant_t empty = make_empty_variant();
+
+    EXPECT_NOT( ( holds_any_of< char, BlowCopyMoveConstruct >( empty ) ) );
+#else
+    EXPECT( !!"holds_any_of<>(): test is not available (no C++11, or std::variant)" );
+#endif
+}
+
+CASE( "variant: Allows to use a set of alternatives as predicate (non-standard, C++11)" )
+{
+#if variant_CPP11_OR_GREATER && ! variant_USES_STD_VARIANT
+    typedef variant< int, long, double, std::string > var_t;
+    std::vector< var_t > vec = { 1, 2L, 3.0, std::string("x"), 5 };
+
+    EXPECT( 3 == std::count_if( vec.begin(), vec.end(), alternative_set< int, double >() ) );
+    EXPECT( 0 == std::count_if( vec.begin(), vec.end(), alternative_set<>() ) );
+#else
+    EXPECT( !!"alternative_set<>: test is not available (no C++11, or std::variant)" );
+#endif
+}
+
 CASE( "variant: Allows to get element by type" )
 {
     variant<int, S> var( S( 7 ) );
@@ -1388,6 +1421,186 @@ CASE( "variant: Allows to compare variants" )
     EXPECT_NOT( v >= w );
 }
 
+#if ( variant_USES_UNION_STORAGE && variant_CPP14_OR_GREATER && ! variant_USES_PROFILE ) || variant_USES_STD_VARIANT
+# define variant_t_HAVE_CONSTEXPR_VARIANT  1
+#else
+# define variant_t_HAVE_CONSTEXPR_VARIANT  0
+#endif
+
+#if ( variant_USES_UNION_STORAGE && variant_CPP14_OR_GREATER && ! variant_USES_PROFILE ) || ( variant_USES_STD_VARIANT && variant_CPP20_OR_GREATER )
+# define variant_t_HAVE_CONSTEXPR_ASSIGNMENT  1
+#else
+# define variant_t_HAVE_CONSTEXPR_ASSIGNMENT  0
+#endif
+
+#if variant_t_HAVE_CONSTEXPR_ASSIGNMENT
+
+namespace {
+
+typedef variant< int, double, char > literal_variant;
+
+constexpr int assign_in_constant_expression()
+{
+    literal_variant v = 1;
+    literal_variant w = 2.5;
+
+    v = w;
+    v = 'x';
+    w = v;
+    w = literal_variant( 7 );
+
+    return get<int>( w ) + ( v == literal_variant( 'x' ) );
+}
+
+} // anonymous namespace
+
+#endif
+
+#if variant_t_HAVE_CONSTEXPR_VARIANT
+
+namespace {
+
+struct literal_weight
+{
+    constexpr int operator()( int    i ) const { return i; }
+    constexpr int operator()( double d ) const { return static_cast<int>( 10 * d ); }
+    constexpr int operator()( char   c ) const { return c - 'a'; }
+
+    template< class T, class U >
+    constexpr int operator()( T t, U u ) const { return (*this)( t ) + (*this)( u ); }
+};
+
+} // anonymous namespace
+
+#endif
+
+#if variant_CPP11_OR_GREATER
+
+namespace {
+
+template< class V >
+struct alternative_sizeof
+{
+    template< std::size_t K >
+    constexpr std::size_t operator()( std::integral_constant< std::size_t, K > ) const
+    {
+        return sizeof( typename variant_alternative< K, V >::type );
+    }
+};
+
+} // anonymous namespace
+
+#endif
+
+CASE( "variant: Allows to construct, copy and compare variants in a constant expression (C++14)" )
+{
+#if variant_t_HAVE_CONSTEXPR_VARIANT
+    typedef variant< int, double, char > var_t;
+
+    constexpr var_t table[] = { 1, 2.5, 'c' };
+    constexpr var_t v( in_place_index<1>, 2.5 );
+    constexpr var_t w( in_place_type<char>, 'c' );
+    constexpr var_t c = v;
+
+    static_assert( table[1] == v && table[2] == w && table[0] < v, "constexpr comparison" );
+    static_assert( c.index() == 1 && get<double>( c ) == 2.5 && holds_alternative<char>( w ), "constexpr access" );
+
+    EXPECT( ( table[1] == c ) );
+    EXPECT( std::is_trivially_destructible< var_t >::value );
+#else
+    EXPECT( !!"variant: constexpr variant is not available (no C++14)" );
+#endif
+}
+
+CASE( "variant: Allows to assign variants in a constant expression (C++14)" )
+{
+#if variant_t_HAVE_CONSTEXPR_ASSIGNMENT
+    static_assert( assign_in_constant_expression() == 8, "constexpr assignment" );
+
+    EXPECT( assign_in_constant_expression() == 8 );
+#else
+    EXPECT( !!"variant: constexpr assignment is not available (no C++14, or std::variant before C++20)" );
+#endif
+}
+
+CASE( "variant: Allows to visit variants in a constant expression (C++14)" )
+{
+#if variant_t_HAVE_CONSTEXPR_VARIANT
+    typedef variant< int, double, char > var_t;
+
+    constexpr var_t v = 2.5;
+    constexpr var_t w = 'd';
+
+    static_assert( visit( literal_weight(), v ) == 25, "constexpr visit" );
+    static_assert( visit( literal_weight(), v, w ) == 28, "constexpr visit of two variants" );
+
+    EXPECT( visit( literal_weight(), w, var_t( 7 ) ) == 10 );
+#else
+    EXPECT( !!"variant: constexpr visit is not available (no C++14)" );
+#endif
+}
+
+CASE( "variant: Allows to destroy, copy and move alternatives via operations shared between variants (non-standard, C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    Tracer::reset();
+    {
+        variant< Tracer, int > a;
+        variant< int, std::string, Tracer, monostate > b( in_place_type<Tracer> );
+        variant< int, std::string, Tracer, monostate > c( b );
+
+        variant< Tracer, int > d( std::move( a ) );
+
+        a = d;
+        b = std::move( c );
+        c = std::string( "shared" );
+
+        EXPECT( Tracer::instances == 3 );
+        EXPECT( get<std::string>( c ) == "shared" );
+    }
+    EXPECT( Tracer::instances == 0 );
+
+# if variant_USES_SHARED_OPS
+    using nonstd::variants::detail::shared_ops_key;
+
+    struct point { int x, y; };
+    struct range { int first, last; };
+    struct fixed { const int x; };
+
+    EXPECT( ( std::is_same< shared_ops_key< point >::type, shared_ops_key< range >::type >::value ) );
+    EXPECT( ( std::is_same< shared_ops_key< std::string >::type, std::string >::value ) );
+
+    // trivially copyable, but not assignable: assignment of the variant does not compile:
+
+    EXPECT( ( std::is_same< shared_ops_key< fixed >::type, fixed >::value ) );
+
+    variant< fixed, int > e( fixed{ 1 } );
+    variant< fixed, int > f( e );
+
+    EXPECT( get< fixed >( f ).x == 1 );
+# endif
+#else
+    EXPECT( !!"variant: shared operations are not available (no C++11)" );
+#endif
+}
+
+CASE( "index_table: Allows to compute a table per alternative at compile time (C++11)" )
+{
+#if variant_CPP11_OR_GREATER
+    typedef variant< char, int, double > var_t;
+
+    constexpr std::array< std::size_t, 3 > sizes = index_table< variant_size< var_t >::value >( alternative_sizeof< var_t >() );
+
+    static_assert( sizes.size() == 3, "constexpr table" );
+
+    EXPECT( sizes[0] == sizeof( char   ) );
+    EXPECT( sizes[1] == sizeof( int    ) );
+    EXPECT( sizes[2] == sizeof( double ) );
+#else
+    EXPECT( !!"index_table: not available (no C++11)" );
+#endif
+}
+
 CASE( "variant: Allows to swap variants, same index (non-member)" )
 {
     variant<int, S> var1( 1 );
@@ -1411,6 +1624,89 @@ CASE( "variant: Allows to swap variants, different index (non-member)" )
     EXPECT(             3 == get<int>( vars )             );
 }
 
+CASE( "variant: Allows to count variants holding a given alternative in a sequence (non-standard)" )
+{
+#if ! variant_USES_STD_VARIANT
+    typedef variant< int, char, std::string > var_t;
+    var_t arr[] = { 1, 'a', 2, std::string("x"), 3, 'b' };
+
+    EXPECT( 3u == count_alternative< int         >( arr, arr + 6 ) );
+    EXPECT( 2u == count_alternative< char        >( arr, arr + 6 ) );
+    EXPECT( 1u == count_alternative< std::string >( arr, arr + 6 ) );
+    EXPECT( 0u == count_alternative< int         >( arr, arr     ) );
+#if variant_CPP11_OR_GREATER
+    std::vector< var_t > vec( arr, arr + 6 );
+
+    EXPECT( 3u == count_alternative< int >( vec ) );
+#endif
+#else
+    EXPECT( !!"count_alternative<>(): test is not available (std::variant)" );
+#endif
+}
+
+CASE( "variant: Allows to find the first variant holding a given alternative in a sequence (non-standard)" )
+{
+#if ! variant_USES_STD_VARIANT
+    typedef variant< int, char, std::string > var_t;
+    var_t arr[] = { 1, 'a', 2, 'b' };
+
+    EXPECT( arr + 0 == find_alternative< int         >( arr, arr + 4 ) );
+    EXPECT( arr + 1 == find_alternative< char        >( arr, arr + 4 ) );
+    EXPECT( arr + 4 == find_alternative< std::string >( arr, arr + 4 ) );
+#else
+    EXPECT( !!"find_alternative<>(): test is not available (std::variant)" );
+#endif
+}
+
+CASE( "variant: Allows to partition a sequence of variants on index (non-standard)" )
+{
+#if ! variant_USES_STD_VARIANT
+    typedef variant< int, char > var_t;
+    var_t arr[] = { 1, 'a', 2, 'b', 3 };
+
+    var_t * mid = partition_by_index( arr, arr + 5, 1 );
+
+    EXPECT( mid == arr + 2 );
+    EXPECT( 2u == count_alternative< char >( arr, mid ) );
+    EXPECT( 3u == count_alternative< int  >( mid, arr + 5 ) );
+#else
+    EXPECT( !!"partition_by_index(): test is not available (std::variant)" );
+#endif
+}
+
+CASE( "variant: Allows to obtain a histogram of the indices in a sequence of variants (non-standard)" )
+{
+#if ! variant_USES_STD_VARIANT
+    typedef variant< int, char, std::string > var_t;
+    var_t arr[] = { 1, 'a', 2, std::string("x"), 3 };
+    std::size_t counts[3] = { 0, 0, 0 };
+
+    index_histogram( arr, arr + 5, counts );
+
+    EXPECT( 3u == counts[0] );
+    EXPECT( 1u == counts[1] );
+    EXPECT( 1u == counts[2] );
+
+    empty_variant_t empty[] = { make_empty_variant(), make_non_empty_variant() };
+    std::size_t empty_counts[2] = { 0, 0 };
+
+    index_histogram( empty, empty + 2, empty_counts );
+
+    EXPECT( 1u == empty_counts[0] );
+    EXPECT( 0u == empty_counts[1] );
+#if variant_CPP11_OR_GREATER
+    std::vector< var_t > vec( arr, arr + 5 );
+    std::array< std::size_t, 3 > hist = index_histogram( vec );
+
+    EXPECT( 3u == hist[0] );
+    EXPECT( 1u == hist[1] );
+    EXPECT( 1u == hist[2] );
+#endif
+#else
+    EXPECT( !!"index_histogram(): test is not available (std::variant)" );
+#endif
+}
+
 //
 // variant helper classes:
 //